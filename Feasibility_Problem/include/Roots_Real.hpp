@@ -35,6 +35,17 @@ class Roots_Real: public TNLP
 
   size_t i_min;
 
+  // Timestep the eigenvalues are currently scaled with (initially 'dtExp')
+  Number dtCurr;
+  // Optimization terminates once the maximum constraint violation is below this tolerance
+  Number FeasTol;
+
+  // Multipliers for warmstart (empty: zero) and of the last optimization
+  std::vector<Number> zL0, zU0, lambda0;
+  std::vector<Number> zLOpt, zUOpt, lambdaOpt;
+
+  bool WriteOutput; // Write solution file in 'finalize_solution'
+
 public:
    /** Constructor */
    Roots_Real(
@@ -181,6 +192,42 @@ public:
       IpoptCalculatedQuantities* ip_cq
    );
 
+   /** Rescale eigenvalues, hull, bounds and starting point from the current timestep to 'dt'.
+    *  The interpolation slopes are invariant under this scaling and reused.
+    */
+   void set_timestep(
+      const Number dt
+   );
+
+   Number get_timestep() const { return dtCurr; }
+
+   /** Overwrite starting point (roots scaled with the current timestep) and multipliers 
+    *  (for 'warm_start_init_point yes')
+    */
+   void set_warm_start(
+      const std::vector<Number>& x0_,
+      const std::vector<Number>& zL0_,
+      const std::vector<Number>& zU0_,
+      const std::vector<Number>& lambda0_
+   );
+
+   /** Bound and constraint multipliers of the last optimization */
+   void get_duals(
+      std::vector<Number>& zL,
+      std::vector<Number>& zU,
+      std::vector<Number>& lambda
+   ) const;
+
+   /** Least constraint-violating roots of the last optimization */
+   std::vector<Number> get_solution() const;
+
+   /** Maximum constraint violation of 'get_solution()' */
+   Number get_min_violation() const { return MinConstrViol; }
+
+   void set_feasibility_tol(const Number FeasTol_) { FeasTol = FeasTol_; }
+
+   void set_write_output(const bool WriteOutput_) { WriteOutput = WriteOutput_; }
+
 private:
 
    /**@name Methods to block default compiler methods.
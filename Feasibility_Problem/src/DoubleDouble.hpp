@@ -0,0 +1,341 @@
+// This code is published under the Eclipse Public License.
+// If you have not obtained a copy of the EPL, you can find the license (version 2.0) at
+// https://www.eclipse.org/legal/epl-2.0/
+//
+// Authors:  Daniel Doehring                  RWTH Aachen University 2022-11-20
+
+#ifndef __DOUBLEDOUBLE_HPP__
+#define __DOUBLEDOUBLE_HPP__
+
+#include <cmath>
+#include <limits>
+#include <algorithm>
+#include <type_traits>
+#include <string>
+#include <ostream>
+#include <sstream>
+#include <iomanip>
+
+/*
+Double-double arithmetic: A number is the unevaluated sum hi + lo of two doubles with |lo| <= ulp(hi) / 2,
+i.e., 106 bits (about 32 decimal digits) of mantissa. Error-free transformations follow Hida, Li & Bailey (QD library),
+products use fused multiply-add. Selected for 'MP_Real' in 'RKCoeffs.hpp' by -DMP_REAL_DOUBLE_DOUBLE,
+almost as accurate as 'cpp_bin_float_quad' (33 digits), but evaluated in hardware (compile with -mfma or -march=native).
+
+The monomial coefficients of high degree polynomials leave the exponent range of double (e.g. 1e-431 for S = 128).
+The value is thus (hi + lo) * 2^Exp with a separate binary exponent, which is only adjusted
+once |hi| leaves [2^-256, 2^256), i.e., usually the plain double-double operations are carried out.
+
+CARE: The error terms vanish under reassociation (-ffast-math, implied by -Ofast).
+All functions of this header are thus compiled without fast-math, independent of the flags of the including file.
+*/
+
+#pragma GCC push_options
+#pragma GCC optimize("no-fast-math")
+
+namespace DD_Detail {
+  // s + e = a + b exactly
+  inline void two_sum(const double a, const double b, double& s, double& e) {
+    s = a + b;
+    const double bb = s - a;
+    e = (a - (s - bb)) + (b - bb);
+  }
+
+  // As 'two_sum', requires |a| >= |b|
+  inline void quick_two_sum(const double a, const double b, double& s, double& e) {
+    s = a + b;
+    e = b - (s - a);
+  }
+
+  // p + e = a * b exactly
+  inline void two_prod(const double a, const double b, double& p, double& e) {
+    p = a * b;
+    e = std::fma(a, b, -p);
+  }
+
+  inline void add(const double ahi, const double alo, const double bhi, const double blo, double& hi, double& lo) {
+    double s, e, t, f;
+    two_sum(ahi, bhi, s, e);
+    two_sum(alo, blo, t, f);
+    e += t;
+    quick_two_sum(s, e, s, e);
+    e += f;
+    quick_two_sum(s, e, hi, lo);
+  }
+
+  inline void mul(const double ahi, const double alo, const double bhi, const double blo, double& hi, double& lo) {
+    double p, e;
+    two_prod(ahi, bhi, p, e);
+    e += ahi * blo + alo * bhi;
+    quick_two_sum(p, e, hi, lo);
+  }
+
+  // Long division with three quotient digits
+  inline void div(const double ahi, const double alo, const double bhi, const double blo, double& hi, double& lo) {
+    const double q1 = ahi / bhi;
+    double rhi, rlo, phi, plo;
+    mul(bhi, blo, q1, 0., phi, plo);
+    add(ahi, alo, -phi, -plo, rhi, rlo);
+    const double q2 = rhi / bhi;
+    mul(bhi, blo, q2, 0., phi, plo);
+    add(rhi, rlo, -phi, -plo, rhi, rlo);
+    const double q3 = rhi / bhi;
+    quick_two_sum(q1, q2, hi, lo);
+    add(hi, lo, q3, 0., hi, lo);
+  }
+}
+
+class DoubleDouble {
+public:
+  DoubleDouble() : hi(0.), lo(0.), Exp(0) {}
+  DoubleDouble(const double x) : hi(x), lo(0.), Exp(0) { normalize(); }
+
+  explicit operator double() const { return std::ldexp(hi, Exp); }
+  explicit operator int() const { return static_cast<int>(static_cast<double>(*this)); }
+
+  DoubleDouble operator-() const { return DoubleDouble(-hi, -lo, Exp); }
+  DoubleDouble operator+() const { return *this; }
+
+  friend DoubleDouble operator+(const DoubleDouble& a, const DoubleDouble& b) {
+    if(a.hi == 0.)
+      return b;
+    if(b.hi == 0.)
+      return a;
+
+    double hi, lo;
+    if(a.Exp == b.Exp) {
+      DD_Detail::add(a.hi, a.lo, b.hi, b.lo, hi, lo);
+      return DoubleDouble(hi, lo, a.Exp);
+    }
+
+    // Different scales: Smaller operand negligible or scaled to the exponent of the larger one
+    const int ExpA = std::ilogb(a.hi) + a.Exp, ExpB = std::ilogb(b.hi) + b.Exp;
+    if(ExpA - ExpB > 110)
+      return a;
+    if(ExpB - ExpA > 110)
+      return b;
+
+    const int Shift = b.Exp - a.Exp;
+    DD_Detail::add(a.hi, a.lo, std::ldexp(b.hi, Shift), std::ldexp(b.lo, Shift), hi, lo);
+    return DoubleDouble(hi, lo, a.Exp);
+  }
+
+  friend DoubleDouble operator-(const DoubleDouble& a, const DoubleDouble& b) { return a + (-b); }
+
+  friend DoubleDouble operator*(const DoubleDouble& a, const DoubleDouble& b) {
+    double hi, lo;
+    DD_Detail::mul(a.hi, a.lo, b.hi, b.lo, hi, lo);
+    return DoubleDouble(hi, lo, a.Exp + b.Exp);
+  }
+
+  friend DoubleDouble operator/(const DoubleDouble& a, const DoubleDouble& b) {
+    double hi, lo;
+    DD_Detail::div(a.hi, a.lo, b.hi, b.lo, hi, lo);
+    return DoubleDouble(hi, lo, a.Exp - b.Exp);
+  }
+
+  // Mixed operations with built-in types (e.g. 'size_t / MP_Real'), otherwise ambiguous
+  template <typename T, typename = typename std::enable_if<std::is_arithmetic<T>::value>::type>
+  friend DoubleDouble operator+(const DoubleDouble& a, const T b) { return a + DoubleDouble(b); }
+  template <typename T, typename = typename std::enable_if<std::is_arithmetic<T>::value>::type>
+  friend DoubleDouble operator+(const T a, const DoubleDouble& b) { return DoubleDouble(a) + b; }
+  template <typename T, typename = typename std::enable_if<std::is_arithmetic<T>::value>::type>
+  friend DoubleDouble operator-(const DoubleDouble& a, const T b) { return a - DoubleDouble(b); }
+  template <typename T, typename = typename std::enable_if<std::is_arithmetic<T>::value>::type>
+  friend DoubleDouble operator-(const T a, const DoubleDouble& b) { return DoubleDouble(a) - b; }
+  template <typename T, typename = typename std::enable_if<std::is_arithmetic<T>::value>::type>
+  friend DoubleDouble operator*(const DoubleDouble& a, const T b) { return a * DoubleDouble(b); }
+  template <typename T, typename = typename std::enable_if<std::is_arithmetic<T>::value>::type>
+  friend DoubleDouble operator*(const T a, const DoubleDouble& b) { return DoubleDouble(a) * b; }
+  template <typename T, typename = typename std::enable_if<std::is_arithmetic<T>::value>::type>
+  friend DoubleDouble operator/(const DoubleDouble& a, const T b) { return a / DoubleDouble(b); }
+  template <typename T, typename = typename std::enable_if<std::is_arithmetic<T>::value>::type>
+  friend DoubleDouble operator/(const T a, const DoubleDouble& b) { return DoubleDouble(a) / b; }
+
+  DoubleDouble& operator+=(const DoubleDouble& b) { return *this = *this + b; }
+  DoubleDouble& operator-=(const DoubleDouble& b) { return *this = *this - b; }
+  DoubleDouble& operator*=(const DoubleDouble& b) { return *this = *this * b; }
+  DoubleDouble& operator/=(const DoubleDouble& b) { return *this = *this / b; }
+
+  friend bool operator==(const DoubleDouble& a, const DoubleDouble& b) { return (a - b).hi == 0.; }
+  friend bool operator!=(const DoubleDouble& a, const DoubleDouble& b) { return (a - b).hi != 0.; }
+  friend bool operator< (const DoubleDouble& a, const DoubleDouble& b) { return (a - b).hi <  0.; }
+  friend bool operator> (const DoubleDouble& a, const DoubleDouble& b) { return (a - b).hi >  0.; }
+  friend bool operator<=(const DoubleDouble& a, const DoubleDouble& b) { return (a - b).hi <= 0.; }
+  friend bool operator>=(const DoubleDouble& a, const DoubleDouble& b) { return (a - b).hi >= 0.; }
+
+  friend DoubleDouble abs(const DoubleDouble& a)  { return (a.hi < 0.) ? -a : a; }
+  friend DoubleDouble fabs(const DoubleDouble& a) { return abs(a); }
+
+  friend DoubleDouble floor(const DoubleDouble& a) {
+    if(a.hi == 0. || !std::isfinite(a.hi))
+      return a;
+    const int Exponent = std::ilogb(a.hi) + a.Exp;
+    if(Exponent >= 106) // Integer
+      return a;
+    if(Exponent < 0)
+      return DoubleDouble(a.hi < 0. ? -1. : 0.);
+
+    // 1 <= |a| < 2^106: Unscaled representation exact
+    const double hi = std::ldexp(a.hi, a.Exp), lo = std::ldexp(a.lo, a.Exp);
+    const double hiFloor = std::floor(hi);
+    // hi integer => lo decides
+    return (hiFloor == hi) ? DoubleDouble(hi, std::floor(lo), 0) : DoubleDouble(hiFloor, 0., 0);
+  }
+
+  // One Newton step on the double approximation (Karp's trick)
+  friend DoubleDouble sqrt(const DoubleDouble& a) {
+    if(a.hi <= 0.)
+      return DoubleDouble(std::sqrt(a.hi));
+
+    // Even exponent
+    const int Odd = a.Exp & 1;
+    const double mhi = std::ldexp(a.hi, Odd), mlo = std::ldexp(a.lo, Odd);
+
+    const double x  = 1. / std::sqrt(mhi);
+    const double ax = mhi * x;
+    double p, e, rhi, rlo, hi, lo;
+    DD_Detail::two_prod(ax, ax, p, e);
+    DD_Detail::add(mhi, mlo, -p, -e, rhi, rlo);
+    DD_Detail::add(ax, 0., rhi * (x * 0.5), 0., hi, lo);
+    return DoubleDouble(hi, lo, (a.Exp - Odd) / 2);
+  }
+
+  friend bool isfinite(const DoubleDouble& a) { return std::isfinite(a.hi); }
+  friend bool isnan(const DoubleDouble& a)    { return std::isnan(a.hi); }
+
+  // Decimal output with the precision of the stream (significant digits), format as for double
+  friend std::ostream& operator<<(std::ostream& os, const DoubleDouble& a) {
+    return os << a.to_string(os.precision(), (os.flags() & std::ios::floatfield) == std::ios::scientific);
+  }
+
+  std::string to_string(std::streamsize Precision, const bool Scientific = false) const {
+    if(!std::isfinite(hi)) {
+      std::ostringstream Str;
+      Str << hi;
+      return Str.str();
+    }
+    if(hi == 0.)
+      return (std::signbit(hi) ? "-0" : "0");
+
+    Precision = std::max<std::streamsize>(std::min<std::streamsize>(Precision, 40), 1);
+
+    // Normalize |x| to [1, 10)
+    DoubleDouble x = abs(*this);
+    int Exponent = static_cast<int>(std::floor(std::log10(std::abs(hi)) + Exp * std::log10(2.)));
+    x = (Exponent >= 0) ? x / pow10(Exponent) : x * pow10(-Exponent);
+    if(x >= DoubleDouble(10.)) {
+      x = x / 10.;
+      Exponent++;
+    }
+    else if(x < DoubleDouble(1.)) {
+      x = x * 10.;
+      Exponent--;
+    }
+
+    // One more digit for rounding
+    std::string Digits(Precision + 1, '0');
+    for(std::streamsize i = 0; i <= Precision; i++) {
+      int d = static_cast<int>(floor(x));
+      d = std::min(std::max(d, 0), 9);
+      Digits[i] = '0' + d;
+      x = (x - static_cast<double>(d)) * 10.;
+    }
+    // Round half up, carry through
+    const bool RoundUp = Digits[Precision] >= '5';
+    Digits.pop_back();
+    if(RoundUp) {
+      std::streamsize i = Precision - 1;
+      while(i >= 0 && Digits[i] == '9')
+        Digits[i--] = '0';
+      if(i >= 0)
+        Digits[i]++;
+      else {
+        Digits.insert(Digits.begin(), '1');
+        Digits.pop_back();
+        Exponent++;
+      }
+    }
+
+    std::string Result = (hi < 0.) ? "-" : "";
+    // As 'std::defaultfloat': Fixed notation for moderate exponents, trailing zeros removed
+    if(Scientific || Exponent < -5 || Exponent >= Precision) {
+      if(!Scientific)
+        Digits.erase(std::max<size_t>(Digits.find_last_not_of('0') + 1, 1));
+      Result += Digits.substr(0, 1);
+      if(Digits.size() > 1)
+        Result += "." + Digits.substr(1);
+      std::ostringstream ExpStr;
+      ExpStr << (Exponent < 0 ? "e-" : "e+") << std::setw(2) << std::setfill('0') << std::abs(Exponent);
+      return Result + ExpStr.str();
+    }
+
+    if(Exponent < 0)
+      Digits.insert(0, std::string(-Exponent, '0'));
+    const size_t PointPos = std::max(Exponent, 0) + 1;
+    std::string IntPart  = Digits.substr(0, PointPos);
+    std::string FracPart = Digits.substr(PointPos);
+    FracPart.erase(FracPart.find_last_not_of('0') + 1);
+
+    return Result + IntPart + (FracPart.empty() ? "" : "." + FracPart);
+  }
+
+private:
+  DoubleDouble(const double hi_, const double lo_, const int Exp_) : hi(hi_), lo(lo_), Exp(Exp_) { normalize(); }
+
+  // Keep |hi| in [2^-256, 2^256) by moving powers of two into 'Exp' (exact)
+  void normalize() {
+    const double Abs = std::abs(hi);
+    if(Abs == 0.) {
+      lo  = 0.;
+      Exp = 0;
+      return;
+    }
+    if((Abs >= 0x1p-256 && Abs < 0x1p256) || !std::isfinite(hi))
+      return;
+
+    const int Shift = std::ilogb(hi);
+    hi   = std::ldexp(hi, -Shift);
+    lo   = std::ldexp(lo, -Shift);
+    Exp += Shift;
+  }
+
+  static DoubleDouble pow10(int n) {
+    DoubleDouble Result(1.), Base(10.);
+    while(n > 0) {
+      if(n & 1)
+        Result *= Base;
+      Base *= Base;
+      n >>= 1;
+    }
+    return Result;
+  }
+
+  double hi, lo;
+  int Exp; // Value is (hi + lo) * 2^Exp
+};
+
+#pragma GCC pop_options
+
+namespace std {
+  template <>
+  class numeric_limits<DoubleDouble> {
+  public:
+    static constexpr bool is_specialized = true;
+    static constexpr bool is_signed      = true;
+    static constexpr bool is_integer     = false;
+    static constexpr bool is_exact       = false;
+    static constexpr bool has_infinity   = true;
+    static constexpr bool has_quiet_NaN  = true;
+    static constexpr int  radix          = 2;
+    static constexpr int  digits         = 106;
+    static constexpr int  digits10       = 31;
+    static constexpr int  max_digits10   = 33;
+
+    static DoubleDouble epsilon()   { return DoubleDouble(4.93038065763132e-32); } // 2^-104
+    static DoubleDouble infinity()  { return DoubleDouble(numeric_limits<double>::infinity()); }
+    static DoubleDouble quiet_NaN() { return DoubleDouble(numeric_limits<double>::quiet_NaN()); }
+  };
+}
+
+#endif // __DOUBLEDOUBLE_HPP__
@@ -0,0 +1,149 @@
+// Copyright (C) 2005, 2006 International Business Machines and others.
+// All Rights Reserved.
+// This code is published under the Eclipse Public License.
+// If you have not obtained a copy of the EPL, you can find the license (version 2.0) at
+// https://www.eclipse.org/legal/epl-2.0/
+//
+// Authors:  Carl Laird, Andreas Waechter     IBM                    2005-08-16
+//           Daniel Doehring                  RWTH Aachen University 2022-11-20
+
+/*
+Search for the maximal timestep for which the (real) feasibility problem is solvable.
+Starting from dt_exp, the timestep is increased (decreased) until an infeasible (feasible) timestep is found 
+and the bracket is then bisected. All solves share the spectrum and interpolation tables of one NLP instance 
+which is only rescaled. Each solve is warmstarted from the roots and multipliers of the last feasible one and 
+terminated as soon as the maximum constraint violation is below 'bisection_feas_tol'.
+*/
+
+#include "IpIpoptApplication.hpp"
+#include "Roots_Real.hpp"
+
+#include <iostream>
+#include <fstream>
+#include <iomanip>
+
+#include "OSPREI_Options.hpp"
+
+using namespace Ipopt;
+
+int main(int argc, char** argv) {
+   assert(argc >= 6);
+
+   const int NumStages    = std::stoi(argv[1]);
+   const int ConsOrder    = std::stoi(argv[2]);
+   const int NumStagesRef = std::stoi(argv[3]);
+   const Number dtRef     = std::stod(argv[4]);
+
+   // Currently only order 1 to 4 are implemented
+   assert(ConsOrder == 1 || ConsOrder == 2 || ConsOrder == 3 || ConsOrder == 4);
+
+   // Create a new instance of IpoptApplication (use Ipopt::SmartPtr)
+   SmartPtr<IpoptApplication> app = IpoptApplicationFactory();
+   register_OSPREI_options(app->RegOptions());
+
+   app->Options()->SetStringValue("output_file", "Roots_Real_Bisection.out");
+
+   // The following overwrites the default name (ipopt.opt) of the options file
+   app->Options()->SetStringValue("option_file_name", "Roots_Real.opt");
+
+   if(ConsOrder == 1)
+      // There are no equality constraints => constant Eq.-Constr. Jacobian (not sure if option does something)
+      app->Options()->SetStringValue("jac_c_constant", "yes");
+
+   // Initialize the IpoptApplication and process the options
+   ApplicationReturnStatus status;
+   status = app->Initialize();
+
+   if( status != Solve_Succeeded ) {
+      std::cout << std::endl << std::endl << "*** Error during initialization!" << std::endl;
+      return (int) status;
+   }
+
+   Number FeasTol, RelTol, Growth;
+   Index MaxSolves;
+   app->Options()->GetNumericValue("bisection_feas_tol", FeasTol, "");
+   app->Options()->GetNumericValue("bisection_rel_tol", RelTol, "");
+   app->Options()->GetNumericValue("bisection_growth", Growth, "");
+   app->Options()->GetIntegerValue("bisection_max_solves", MaxSolves, "");
+
+   SmartPtr<Roots_Real> mynlp;
+   if(argc == 7)
+      // Case for which hull is used
+      mynlp = new Roots_Real(NumStages, ConsOrder, NumStagesRef, dtRef, std::string(argv[5]), std::string(argv[6]));
+   else
+      mynlp = new Roots_Real(NumStages, ConsOrder, NumStagesRef, dtRef, std::string(argv[5]));
+
+   mynlp->set_feasibility_tol(FeasTol);
+   mynlp->set_write_output(false);
+
+   // Bracket [dtLow, dtHigh]: dtLow feasible (0: none found yet), dtHigh infeasible (0: none found yet)
+   Number dtLow = 0., dtHigh = 0.;
+   Number dt = mynlp->get_timestep();
+
+   // Last feasible solution (roots scaled with 'dtLow') and multipliers for warmstart
+   std::vector<Number> xFeas, zLFeas, zUFeas, lambdaFeas;
+
+   Index NumSolves = 0;
+   while(NumSolves < MaxSolves) {
+      mynlp->set_timestep(dt);
+      if(!xFeas.empty()) {
+         std::vector<Number> xWarm(xFeas);
+         for(size_t i = 0; i < xWarm.size(); i++)
+            xWarm[i] *= dt / dtLow;
+         mynlp->set_warm_start(xWarm, zLFeas, zUFeas, lambdaFeas);
+      }
+
+      status = app->OptimizeTNLP(GetRawPtr(mynlp));
+      NumSolves++;
+
+      const bool Feasible = mynlp->get_min_violation() <= FeasTol;
+      std::cout << std::endl << "### Solve " << NumSolves << ": dt = " << dt << " is " 
+                << (Feasible ? "feasible" : "infeasible") << " (max. violation " 
+                << mynlp->get_min_violation() << ") ###" << std::endl << std::endl;
+
+      if(Feasible) {
+         dtLow = dt;
+         xFeas = mynlp->get_solution();
+         mynlp->get_duals(zLFeas, zUFeas, lambdaFeas);
+         app->Options()->SetStringValue("warm_start_init_point", "yes");
+      }
+      else
+         dtHigh = dt;
+
+      if(dtHigh == 0.)
+         dt *= Growth; // Bracketing: Increase until infeasible
+      else if(dtLow == 0.)
+         dt /= Growth; // Bracketing: Decrease until feasible
+      else {
+         if((dtHigh - dtLow) <= RelTol * dtLow)
+            break;
+         dt = 0.5 * (dtLow + dtHigh);
+      }
+   }
+
+   if(dtLow == 0.) {
+      std::cout << std::endl << "CARE: No feasible timestep found!" << std::endl;
+      return (int) status;
+   }
+   if(dtHigh == 0. || (dtHigh - dtLow) > RelTol * dtLow)
+      std::cout << std::endl << "CARE: Bisection did not reach the requested tolerance!" << std::endl;
+
+   std::cout.precision(std::numeric_limits<Number>::max_digits10);
+   std::cout << std::endl << "Largest feasible timestep: " << dtLow << " (" << NumSolves << " solves)" << std::endl;
+   std::cout << "Corresponding reference timestep (for subsequent runs): " 
+             << dtLow / NumStages * NumStagesRef << std::endl;
+
+   // Roots scaled with 'dtLow', i.e., consistent with the reference timestep above
+   std::ofstream RealOptFile("./Real_Optimized_" + std::to_string(NumStages) + ".txt");
+   RealOptFile << std::setprecision(std::numeric_limits<Number>::max_digits10);
+   for(size_t i = 0; i < xFeas.size(); i++) {
+      RealOptFile << xFeas[i];
+      if(i != xFeas.size() - 1)
+         RealOptFile << "\n";
+   }
+   RealOptFile.close();
+
+   std::cout << std::endl << std::endl << "*** The problem terminated!" << std::endl;
+
+   return (int) status;
+}
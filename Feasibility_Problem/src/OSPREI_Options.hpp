@@ -0,0 +1,37 @@
+// This code is published under the Eclipse Public License.
+// If you have not obtained a copy of the EPL, you can find the license (version 2.0) at
+// https://www.eclipse.org/legal/epl-2.0/
+//
+// Authors:  Daniel Doehring                  RWTH Aachen University 2022-11-20
+
+#ifndef __OSPREI_OPTIONS_HPP__
+#define __OSPREI_OPTIONS_HPP__
+
+#include "IpIpoptApplication.hpp"
+
+using namespace Ipopt;
+
+/*
+Options specific to OSPREI. These are registered with Ipopt such that they can be set 
+in the very same parameter files (Roots_Real.opt, Roots_RealImag.opt) as the Ipopt options.
+Must be called before 'app->Initialize()', which reads the parameter file.
+*/
+inline void register_OSPREI_options(const SmartPtr<RegisteredOptions>& roptions) {
+  roptions->SetRegisteringCategory("OSPREI");
+
+  /// Timestep bisection ///
+  roptions->AddLowerBoundedNumberOption("bisection_feas_tol",
+    "A timestep is accepted as feasible if the maximum constraint violation is below this value.",
+    0., true, 1e-10);
+  roptions->AddLowerBoundedNumberOption("bisection_rel_tol",
+    "Bisection stops once the bracket [dt_feasible, dt_infeasible] is relatively smaller than this value.",
+    0., true, 1e-3);
+  roptions->AddLowerBoundedNumberOption("bisection_growth",
+    "Factor by which the timestep is increased (decreased) to find an infeasible (feasible) bracket end.",
+    1., true, 1.5);
+  roptions->AddLowerBoundedIntegerOption("bisection_max_solves",
+    "Maximum number of feasibility solves (bracketing and bisection).",
+    1, 40);
+}
+
+#endif
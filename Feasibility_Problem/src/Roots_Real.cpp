@@ -95,6 +95,10 @@ Roots_Real::Roots_Real(
 
    xMinConstraintViolation = new Number[NumUnknowns];
    ConstraintsViol = new Number[NumConstr];
+
+   dtCurr      = dtExp;
+   FeasTol     = std::numeric_limits<Number>::epsilon();
+   WriteOutput = true;
 }
 
  Roots_Real::Roots_Real(
@@ -176,6 +180,10 @@ Roots_Real::Roots_Real(
 
    xMinConstraintViolation = new Number[NumUnknowns];
    ConstraintsViol = new Number[NumConstr];
+
+   dtCurr      = dtExp;
+   FeasTol     = std::numeric_limits<Number>::epsilon();
+   WriteOutput = true;
 }
 
 // destructor
@@ -299,9 +307,16 @@ bool Roots_Real::get_starting_point(
       x[i] = x0[i];
    }
 
+   // Multipliers are only requested for 'warm_start_init_point yes'
+   if(init_z)
+      for( Index i = 0; i < n; i++ ) {
+         z_L[i] = (zL0.size() == n) ? zL0[i] : 0.;
+         z_U[i] = (zU0.size() == n) ? zU0[i] : 0.;
+      }
+
    if(init_lambda)
       for( Index i = 0; i < m; i++ ) {
-         lambda[i] = 0.;
+         lambda[i] = (lambda0.size() == m) ? lambda0[i] : 0.;
       }
 
    return true;
@@ -957,6 +972,8 @@ bool Roots_Real::intermediate_callback(
 
    if(iter == 0) {
       MinConstrViol = CurrViol;
+      // Starting point may already be feasible (warmstart)
+      get_curr_iterate(ip_data, ip_cq, false, NumUnknowns, xMinConstraintViolation, NULL, NULL, NumConstr, NULL, NULL);
    }
    else {
       if(CurrViol < MinConstrViol) {
@@ -965,9 +982,9 @@ bool Roots_Real::intermediate_callback(
       }
    }
 
-   // Terminates at first feasible point (although in practice never reached)
+   // Terminates at first feasible point (for default 'FeasTol' in practice never reached)
    // IDEA: Let run for some more time to get "increased stability" ?
-   if(CurrViol <= std::numeric_limits<Number>::epsilon())
+   if(CurrViol <= FeasTol)
       return false;
    else
       return true;
@@ -1015,16 +1032,22 @@ void Roots_Real::finalize_solution(
       }
    }
 
-   std::ofstream RealOptFile("./Real_Optimized_" + std::to_string(NumStages) + ".txt");
-   for(size_t i = 0; i < n; i++) {
-      std::stringstream StringStr; // On purpose within loop (automatic reset)
-      StringStr << std::setprecision(std::numeric_limits<Number>::max_digits10);
-      StringStr << xMinConstraintViolation[i];
-      RealOptFile << StringStr.str();
-      if(i != n-1)
-         RealOptFile << "\n";
+   zLOpt.assign(z_L, z_L + n);
+   zUOpt.assign(z_U, z_U + n);
+   lambdaOpt.assign(lambda, lambda + m);
+
+   if(WriteOutput) {
+      std::ofstream RealOptFile("./Real_Optimized_" + std::to_string(NumStages) + ".txt");
+      for(size_t i = 0; i < n; i++) {
+         std::stringstream StringStr; // On purpose within loop (automatic reset)
+         StringStr << std::setprecision(std::numeric_limits<Number>::max_digits10);
+         StringStr << xMinConstraintViolation[i];
+         RealOptFile << StringStr.str();
+         if(i != n-1)
+            RealOptFile << "\n";
+      }
+      RealOptFile.close();
    }
-   RealOptFile.close();
 
    /*
    std::cout << std::endl << std::endl << "Solution of the bound multipliers, z_L and z_U" << std::endl;
@@ -1060,3 +1083,59 @@ void Roots_Real::finalize_solution(
    }
 }
 // [TNLP_finalize_solution]
+
+void Roots_Real::set_timestep(
+   const Number dt
+)
+{
+   const Number Factor = dt / dtCurr;
+
+   for(size_t i = 0; i < NumEigVals; i++) {
+      RealEigValsScaled[i] *= Factor;
+      ImagEigValsScaled[i] *= Factor;
+   }
+   for(size_t i = 0; i < HullRealScaled.size(); i++) {
+      HullRealScaled[i] *= Factor;
+      HullImagScaled[i] *= Factor;
+   }
+   // Slopes 'ImagDiff_over_RealDiff' are invariant under the (isotropic) scaling
+
+   RealUB  = std::min(RealEigValsScaled[NumEigVals-1], -1e-9); // Division by zero guard
+   RealMin = *min_element(std::begin(RealEigValsScaled), std::end(RealEigValsScaled));
+
+   // Roots keep their position relative to the spectrum
+   for(size_t i = 0; i < NumUnknowns; i++)
+      x0[i] *= Factor;
+
+   dtCurr = dt;
+}
+
+void Roots_Real::set_warm_start(
+   const std::vector<Number>& x0_,
+   const std::vector<Number>& zL0_,
+   const std::vector<Number>& zU0_,
+   const std::vector<Number>& lambda0_
+)
+{
+   assert(x0_.size() == NumUnknowns);
+   x0      = x0_;
+   zL0     = zL0_;
+   zU0     = zU0_;
+   lambda0 = lambda0_;
+}
+
+void Roots_Real::get_duals(
+   std::vector<Number>& zL,
+   std::vector<Number>& zU,
+   std::vector<Number>& lambda
+) const
+{
+   zL     = zLOpt;
+   zU     = zUOpt;
+   lambda = lambdaOpt;
+}
+
+std::vector<Number> Roots_Real::get_solution() const
+{
+   return std::vector<Number>(xMinConstraintViolation, xMinConstraintViolation + NumUnknowns);
+}
@@ -13,6 +13,10 @@
 #include "IpTNLP.hpp"
 #include "dco.hpp"
 #include <vector>
+#include <atomic>
+
+#include "SolveBudget.hpp"
+#include "Aggregation.hpp"
 
 using namespace Ipopt;
 
@@ -33,6 +37,35 @@ class Roots_Real: public TNLP
 
   Number *xMaxdt, Maxdt, InfPr;
 
+  // Smooth aggregation of the stability constraints over blocks of eigenvalues
+  StabConstrAggregation Aggregation;
+  int NumStabConstr; // NumEigVals without aggregation, number of blocks otherwise
+  Number AggrParam; // rho (KS) or P (p-norm)
+  std::vector<Number> StabConstrValues; // Passive values of the non-aggregated constraints
+
+  // Multipliers for warmstart (empty: zero) and of the best iterate of the last optimization (matching 'xMaxdt')
+  std::vector<Number> zL0, zU0, lambda0;
+  std::vector<Number> zLOpt, zUOpt, lambdaOpt;
+
+  bool WriteOutput; // Write solution files in 'finalize_solution'
+  std::string WarmStartFile; // Persisted primal-dual solution (empty: no persistence)
+
+  // Multi-start: Timestep of the best feasible iterate of all concurrent starts (shared memory)
+  std::atomic<Number>* Incumbent;
+  Number AbortMargin, FeasTol;
+  Index AbortIter;
+
+  // Wall-clock and stagnation termination
+  SolveBudget Budget;
+
+  // "text": One text file per quantity, "bundle": 'Result_Real_S.json' + 'Result_Real_S.bin', "both"
+  std::string ResultFormat;
+
+  // Periodic checkpoints (interval 0: none) and restart from them
+  Index CheckpointInterval, IterOffset;
+  std::string CheckpointFile;
+  bool KeepBest; // Do not reset the best iterate in 'get_starting_point' (resumed run)
+
 public:
    /** Constructor */
    // NOTE: This is not the real application case
@@ -41,7 +74,8 @@ public:
       const int ConsOrder_,
       const int NumStagesRef_,
       const Number dtRef_,
-      const std::string EigValFileName
+      const std::string EigValFileName,
+      const Number DedupTol = 0.
    );
 
    Roots_Real(
@@ -50,7 +84,24 @@ public:
       const int NumStagesRef_,
       const Number dtRef_,
       const std::string EigValFileName,
-      const std::string HullPointPath
+      const std::string HullPointPath,
+      const Number DedupTol = 0.
+   );
+
+   /** Constructor for in-memory (unscaled) constraint points and interpolation curve.
+    *  'Real_PE_HalfStages': Real parts of the (scaled) roots of the NumStages/2 optimization for initialization.
+    *  If empty, the file 'RealImag_Optimized_<NumStages/2>.txt' is used (if present).
+    */
+   Roots_Real(
+      const int NumStages_,
+      const int ConsOrder_,
+      const int NumStagesRef_,
+      const Number dtRef_,
+      const std::vector<Number>& RealEigVals,
+      const std::vector<Number>& ImagEigVals,
+      const std::vector<Number>& HullReal,
+      const std::vector<Number>& HullImag,
+      const std::vector<Number>& Real_PE_HalfStages = std::vector<Number>()
    );
 
    /** Destructor */
@@ -180,8 +231,166 @@ public:
       IpoptCalculatedQuantities* ip_cq
    );
 
+   /** Overwrite the starting point (roots and timestep, scaled) */
+   void set_initial_point(
+      const std::vector<Number>& x0_
+   );
+
+   /** Overwrite starting point and multipliers (for 'warm_start_init_point yes') */
+   void set_warm_start(
+      const std::vector<Number>& x0_,
+      const std::vector<Number>& zL0_,
+      const std::vector<Number>& zU0_,
+      const std::vector<Number>& lambda0_
+   );
+
+   /** Bound and constraint multipliers of the best iterate of the last optimization, see 'get_solution' */
+   void get_duals(
+      std::vector<Number>& zL,
+      std::vector<Number>& zU,
+      std::vector<Number>& lambda
+   ) const;
+
+   /** Best (roots, timestep) found during the last optimization */
+   std::vector<Number> get_solution() const;
+
+   /** Value of |R(z)| of the best solution for an unscaled eigenvalue z */
+   Number eval_AbsStabPnom(
+      const Number RealEV,
+      const Number ImagEV
+   ) const;
+
+   Number get_dtExp() const { return dtExp; }
+
+   /** Bounds of the (scaled) real parts of the roots, see 'get_bounds_info' */
+   Number get_RealMin() const { return RealMin; }
+   Number get_RealUB()  const { return RealUB; }
+
+   std::vector<Number> get_initial_point() const { return x0; }
+
+   /** Primal infeasibility of the best solution found during the last optimization */
+   Number get_infeasibility() const { return InfPr; }
+
+   /** Overwrite the best solution, e.g. to write the files for a solution obtained elsewhere */
+   void set_solution(
+      const std::vector<Number>& x
+   );
+
+   /** Write Real_Optimized_S.txt and PE_S.txt for the best solution */
+   void write_solution_files();
+
+   /** Write the output of the best solution as 'finalize_solution' does, i.e., text files and/or result bundle */
+   void write_results();
+
+   void set_write_output(const bool WriteOutput_) { WriteOutput = WriteOutput_; }
+
+   /** Persist the primal-dual solution in 'finalize_solution' to a binary file keyed by the problem signature.
+    *  Returns true if a solution of a previous run was loaded as warmstart ('warm_start_init_point yes').
+    */
+   bool enable_warm_start_persistence();
+
+   /** Replace the starting point by the nearest solution (same order p) of the database in 'DataBaseDir',
+    *  mapped onto this spectrum. Returns false if the database holds no record closer than 'MaxDist'.
+    */
+   bool init_from_database(
+      const std::string DataBaseDir,
+      const Number      MaxDist
+   );
+
+   /** Append the best solution, normalized by dtExp and curve length, to the database in 'DataBaseDir' */
+   void store_in_database(
+      const std::string DataBaseDir
+   ) const;
+
+   /** Publish feasible timesteps to 'Incumbent_' and abort (after 'AbortIter_' iterations) if the current
+    *  timestep is smaller than (1 - 'AbortMargin_') times the incumbent.
+    */
+   void set_incumbent(
+      std::atomic<Number>* Incumbent_,
+      const Number         AbortMargin_,
+      const Number         FeasTol_,
+      const Index          AbortIter_
+   );
+
+   /** Stop 'TimeBudget' seconds after this call, shared by all following solves (0: unlimited), or if the best timestep did not improve by more than
+    *  'StagnationTol' (relative) over 'StagnationIter' iterations (0: off), see 'SolveBudget'
+    */
+   void set_budget(
+      const Number TimeBudget,
+      const Index  StagnationIter,
+      const Number StagnationTol,
+      const Number StagnationFeasTol
+   );
+
+   /** Output as text files ("text", default), result bundle ("bundle") or both ("both") */
+   void set_result_format(
+      const std::string Format
+   );
+
+   /** Write current iterate, multipliers and best iterate to 'Checkpoint_Real_S.bin' every 'Interval' iterations */
+   void set_checkpointing(
+      const Index Interval
+   );
+
+   /** Warmstart from the checkpoint of an interrupted run and continue its best iterate bookkeeping.
+    *  Returns the iteration of the checkpoint (-1: no checkpoint of this problem found) and its barrier parameter 'mu'.
+    */
+   Index resume_from_checkpoint(
+      Number& mu
+   );
+
+   /** Switch between m separate stability constraints and 'NumBlocks' aggregated ones.
+    *  Changes the number of constraints, thus call only in between optimizations.
+    */
+   void set_aggregation(
+      const StabConstrAggregation Aggregation_,
+      const int                   NumBlocks,
+      const Number                AggrParam_
+   );
+
 private:
 
+   /** Exact (non-aggregated) constraints of the best solution, reports violated ones */
+   void eval_exact_constraints(
+      Number* Constr
+   );
+
+   /** Text files and/or result bundle according to 'ResultFormat' */
+   void write_output(
+      const Number* Constr
+   );
+
+   void write_result_bundle(
+      const Number* Constr
+   );
+
+   void write_checkpoint(
+      const Index                iter,
+      const Number               mu,
+      const IpoptData*           ip_data,
+      IpoptCalculatedQuantities* ip_cq
+   );
+
+   /** Passive values of all (non-aggregated) stability constraints, determines 'i_min' */
+   void eval_StabConstr(
+      const Number* x,
+      Number*       gStab
+   );
+
+   /** Stability constraint of the i'th eigenvalue (for the Hessian) */
+   template<typename T>
+   T StabConstr_i(
+      const std::vector<T>& x,
+      const size_t          i
+   );
+
+   /** Aggregated stability constraint of a block, uses 'StabConstrValues' for the shift */
+   template<typename T>
+   T aggregate_StabConstr(
+      const T*     gStab,
+      const size_t Block
+   ) const;
+
    /**@name Methods to block default compiler methods.
     *
     * The compiler automatically generates the following three methods.
@@ -14,6 +14,9 @@
 #include "dco.hpp"
 #include <vector>
 
+#include "SolveBudget.hpp"
+#include "Aggregation.hpp"
+
 using namespace Ipopt;
 
 class Roots_RealImag: public TNLP
@@ -34,6 +37,34 @@ public:
 
   size_t i_min;
 
+  // Smooth aggregation of the stability constraints over blocks of eigenvalues
+  StabConstrAggregation Aggregation;
+  int NumStabConstr; // NumEigVals without aggregation, number of blocks otherwise
+  Number AggrParam; // rho (KS) or P (p-norm)
+  std::vector<Number> StabConstrValues; // Passive values of the non-aggregated constraints
+
+  // Last solution
+  std::vector<Number> xyOpt, zLOpt, zUOpt, lambdaOpt;
+
+  std::string WarmStartFile; // Persisted primal-dual solution (empty: no persistence)
+
+  // Best iterate (largest timestep among the least infeasible ones) and its multipliers, written if the solve is stopped
+  std::vector<Number> xyBest, zLBest, zUBest, lambdaBest;
+  Number BestObj, BestInfPr;
+
+  // Wall-clock and stagnation termination
+  SolveBudget Budget;
+
+  bool WriteOutput; // Write solution files and P-ERK coefficients in 'finalize_solution'
+
+  // "text": One text file per quantity, "bundle": 'Result_RealImag_S.json' + 'Result_RealImag_S.bin', "both"
+  std::string ResultFormat;
+
+  // Periodic checkpoints (interval 0: none) and restart from them
+  Index CheckpointInterval, IterOffset;
+  std::string CheckpointFile;
+  bool KeepBest; // Do not reset the best iterate in 'get_starting_point' (resumed run)
+
    /** Constructor */
    // NOTE: This is not the real application case (no hull)
    Roots_RealImag(
@@ -41,7 +72,8 @@ public:
       const int ConsOrder_,
       const int NumStagesRef_,
       const Number dtRef_,
-      const std::string EigValFileName
+      const std::string EigValFileName,
+      const Number DedupTol = 0.
    );
 
    Roots_RealImag(
@@ -50,7 +82,23 @@ public:
       const int NumStagesRef_,
       const Number dtRef_,
       const std::string EigValFileName,
-      const std::string HullPointPath
+      const std::string HullPointPath,
+      const Number DedupTol = 0.
+   );
+
+   /** Constructor for in-memory (unscaled) constraint points and interpolation curve.
+    *  'xReal': Solution (roots, timestep) of Roots_Real, e.g. from 'read_x0_Result'.
+    */
+   Roots_RealImag(
+      const int NumStages_,
+      const int ConsOrder_,
+      const int NumStagesRef_,
+      const Number dtRef_,
+      const std::vector<Number>& RealEigVals,
+      const std::vector<Number>& ImagEigVals,
+      const std::vector<Number>& HullReal,
+      const std::vector<Number>& HullImag,
+      const std::vector<Number>& xReal
    );
 
    /** Destructor */
@@ -180,8 +228,95 @@ public:
       IpoptCalculatedQuantities* ip_cq
    );
 
+   /** Overwrite starting point (roots, corrections and timestep, scaled) and multipliers
+    *  (for 'warm_start_init_point yes'). Empty vectors: 'xy0' without corrections and zero multipliers.
+    */
+   void set_warm_start(
+      const std::vector<Number>& xy_,
+      const std::vector<Number>& zL0_,
+      const std::vector<Number>& zU0_,
+      const std::vector<Number>& lambda0_
+   );
+
+   /** Persist the primal-dual solution in 'finalize_solution' to a binary file keyed by the problem signature.
+    *  Returns true if a solution of a previous run was loaded as warmstart ('warm_start_init_point yes').
+    */
+   bool enable_warm_start_persistence();
+
+   /** Output as text files ("text", default), result bundle ("bundle") or both ("both") */
+   void set_result_format(
+      const std::string Format
+   );
+
+   void write_solution_files(
+      const Number* xy
+   );
+
+   void set_write_output(const bool WriteOutput_) { WriteOutput = WriteOutput_; }
+
+   /** Write current iterate, multipliers and best iterate to 'Checkpoint_RealImag_S.bin' every 'Interval' iterations */
+   void set_checkpointing(
+      const Index Interval
+   );
+
+   /** Warmstart from the checkpoint of an interrupted run and continue its best iterate bookkeeping.
+    *  Returns the iteration of the checkpoint (-1: no checkpoint of this problem found) and its barrier parameter 'mu'.
+    */
+   Index resume_from_checkpoint(
+      Number& mu
+   );
+
+   /** Stop 'TimeBudget' seconds after this call, shared by all following solves (0: unlimited), or if the best timestep did not improve by more than
+    *  'StagnationTol' (relative) over 'StagnationIter' iterations (0: off), see 'SolveBudget'
+    */
+   void set_budget(
+      const Number TimeBudget,
+      const Index  StagnationIter,
+      const Number StagnationTol,
+      const Number StagnationFeasTol
+   );
+
+   /** Switch between m separate stability constraints and 'NumBlocks' aggregated ones.
+    *  Changes the number of constraints, thus call only in between optimizations.
+    */
+   void set_aggregation(
+      const StabConstrAggregation Aggregation_,
+      const int                   NumBlocks,
+      const Number                AggrParam_
+   );
+
 private:
 
+   /** Passive values of all (non-aggregated) stability constraints, determines 'i_min' */
+   void eval_StabConstr(
+      const Number* xy,
+      Number*       gStab
+   );
+
+   /** Stability constraint of the i'th eigenvalue (for the Hessian) */
+   template<typename T>
+   T StabConstr_i(
+      const std::vector<T>& xy,
+      const size_t          i
+   );
+
+   /** Aggregated stability constraint of a block, uses 'StabConstrValues' for the shift */
+   template<typename T>
+   T aggregate_StabConstr(
+      const T*     gStab,
+      const size_t Block
+   ) const;
+
+   void write_checkpoint(
+      const Index                iter,
+      const Number               mu,
+      const IpoptData*           ip_data,
+      IpoptCalculatedQuantities* ip_cq
+   );
+
+   // Warmstart (empty: start from 'xy0' without corrections and zero multipliers)
+   std::vector<Number> xyWarm, zL0, zU0, lambda0;
+
    /**@name Methods to block default compiler methods.
     *
     * The compiler automatically generates the following three methods.
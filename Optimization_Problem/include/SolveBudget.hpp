@@ -0,0 +1,74 @@
+// This code is published under the Eclipse Public License.
+// If you have not obtained a copy of the EPL, you can find the license (version 2.0) at
+// https://www.eclipse.org/legal/epl-2.0/
+//
+// Authors:  Daniel Doehring                  RWTH Aachen University 2022-11-20
+
+#ifndef __SOLVEBUDGET_HPP__
+#define __SOLVEBUDGET_HPP__
+
+#include <chrono>
+#include <iostream>
+#include <algorithm>
+
+/*
+Termination criteria beyond Ipopt's own, evaluated in 'intermediate_callback' (returning false stops Ipopt
+with 'User_Requested_Stop', the best iterate is still written in 'finalize_solution'):
+- Wall-clock budget per run (seconds, 0: unlimited), i.e., shared by all solves (aggregation continuation, polish)
+  after 'start_run'. Once it is exhausted, later solves stop at their first iteration.
+- Stagnation: The best timestep did not improve by more than a relative 'StagnationTol' over 'StagnationIter'
+  iterations (0: off). Counting starts once the best iterate is feasible up to 'StagnationFeasTol'.
+*/
+struct SolveBudget {
+  double TimeBudget = 0.;
+  int StagnationIter = 0;
+  double StagnationTol = 1e-6, StagnationFeasTol = 1e-8;
+
+  std::chrono::steady_clock::time_point StartTime = std::chrono::steady_clock::now();
+  int LastImprovementIter = -1;
+  double LastImprovementdt = 0.;
+
+  // Call once per run (i.e., in 'set_budget'): Starts the wall clock
+  void start_run() {
+    StartTime = std::chrono::steady_clock::now();
+  }
+
+  // Call at the beginning of every solve (i.e., in 'get_starting_point'): Resets the stagnation criterion
+  void start() {
+    LastImprovementIter = -1;
+    LastImprovementdt   = 0.;
+
+    if(TimeBudget > 0.)
+      std::cout << "Remaining time budget: " << std::max(TimeBudget - elapsed(), 0.) << "s" << std::endl;
+  }
+
+  double elapsed() const {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - StartTime).count();
+  }
+
+  // Returns false if the solve should be stopped
+  bool check(const int iter, const double Bestdt, const double BestInfPr) {
+    if(TimeBudget > 0.) {
+      if(elapsed() >= TimeBudget) {
+        std::cout << "Stop: Time budget of " << TimeBudget << "s exhausted" << std::endl;
+        return false;
+      }
+    }
+
+    if(StagnationIter > 0 && BestInfPr <= StagnationFeasTol) {
+      if(LastImprovementIter < 0 || Bestdt > (1. + StagnationTol) * LastImprovementdt) {
+        LastImprovementIter = iter;
+        LastImprovementdt   = Bestdt;
+      }
+      else if(iter - LastImprovementIter >= StagnationIter) {
+        std::cout << "Stop: Best timestep " << Bestdt << " did not improve over " << StagnationIter 
+                  << " iterations" << std::endl;
+        return false;
+      }
+    }
+
+    return true;
+  }
+};
+
+#endif
@@ -0,0 +1,88 @@
+// This code is published under the Eclipse Public License.
+// If you have not obtained a copy of the EPL, you can find the license (version 2.0) at
+// https://www.eclipse.org/legal/epl-2.0/
+//
+// Authors:  Daniel Doehring                  RWTH Aachen University 2022-11-20
+
+#ifndef __AGGREGATION_HPP__
+#define __AGGREGATION_HPP__
+
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <algorithm>
+
+/** Treatment of the stability constraints |R(z_i)| <= 1 */
+enum StabConstrAggregation { NoAggregation, KS_Aggregation, PNorm_Aggregation };
+
+/*
+Smooth, conservative approximations to max_i g_i for a block of stability constraints g_i = |R(z_i)|.
+
+Kreisselmeier-Steinhauser: max_i g_i <= KS(g) <= max_i g_i + log(N)/rho
+p-norm:                    max_i g_i <= ||g||_P <= N^(1/P) max_i g_i
+
+'shift' is the (passive) maximum of the block. It does not change value nor derivatives,
+but keeps exp/pow from overflowing for large aggregation parameters.
+*/
+
+// T: for dco types (or usual real types)
+template<typename T>
+T KS_Aggregate(const T* g, const size_t NumVals, const double rho, const double shift) {
+  using std::exp; using std::log; // Use dco overloads (ADL) for dco types
+
+  T sum = 0.;
+  for(size_t i = 0; i < NumVals; i++)
+    sum += exp(rho * (g[i] - shift));
+
+  return shift + log(sum) / rho;
+}
+
+template<typename T>
+T PNorm_Aggregate(const T* g, const size_t NumVals, const double P, const double shift) {
+  using std::pow; // Use dco overloads (ADL) for dco types
+
+  T sum = 0.;
+  for(size_t i = 0; i < NumVals; i++)
+    sum += pow(g[i] / shift, P);
+
+  return shift * pow(sum, 1. / P);
+}
+
+template<typename T>
+T Aggregate(const StabConstrAggregation Aggregation, const T* g, const size_t NumVals, 
+            const double Param, const double shift) {
+  if(Aggregation == KS_Aggregation)
+    return KS_Aggregate(g, NumVals, Param, shift);
+  else
+    return PNorm_Aggregate(g, NumVals, Param, shift);
+}
+
+// Passive maximum of a block as shift
+inline double BlockShift(const double* g, const size_t NumVals) {
+  double shift = std::numeric_limits<double>::min(); // p-norm: Division-by-zero guard
+  for(size_t i = 0; i < NumVals; i++)
+    shift = std::max(shift, g[i]);
+
+  return shift;
+}
+
+/*
+The first and second derivatives of the aggregate w.r.t. g_i are (relative to those w.r.t. the block maximum)
+bounded by exp(rho (g_i - shift)) for KS and by (g_i/shift)^(P-2) for the p-norm with P >= 2.
+Below machine precision, g_i does not contribute to the Hessian in working precision and need not be taped.
+*/
+inline bool HessianNegligible(const StabConstrAggregation Aggregation, const double g_i, 
+                              const double Param, const double shift) {
+  const double Eps = std::numeric_limits<double>::epsilon();
+  if(Aggregation == KS_Aggregation)
+    return Param * (g_i - shift) < std::log(Eps);
+  else
+    return Param > 2. && (Param - 2.) * std::log(g_i / shift) < std::log(Eps);
+}
+
+// Contiguous blocks of eigenvalues (sorted by real part, i.e., neighbors behave similarly)
+inline size_t BlockBegin(const size_t Block, const size_t NumBlocks, const size_t NumVals) {
+  return (Block * NumVals) / NumBlocks;
+}
+
+#endif
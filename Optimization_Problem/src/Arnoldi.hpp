@@ -0,0 +1,349 @@
+// This code is published under the Eclipse Public License.
+// If you have not obtained a copy of the EPL, you can find the license (version 2.0) at
+// https://www.eclipse.org/legal/epl-2.0/
+//
+// Authors:  Daniel Doehring                  RWTH Aachen University 2022-11-20
+
+#ifndef __ARNOLDI_HPP__
+#define __ARNOLDI_HPP__
+
+#include <string>
+#include <vector>
+#include <complex>
+#include <fstream>
+#include <sstream>
+#include <iostream>
+#include <random>
+#include <algorithm>
+#include <numeric>
+#include <functional>
+#include <cmath>
+#include <cassert>
+
+#include <eigen3/Eigen/Dense>
+#include <eigen3/Eigen/Sparse>
+
+#include "Spectra.hpp"      // For 'UpperConvexHull'
+#include "SemiInfinite.hpp" // For 'CurveArcLengths', 'CurvePoint'
+
+/*
+Boundary eigenvalues of a sparse Jacobian by the implicitly restarted Arnoldi method (IRAM).
+Complex arithmetic throughout, such that also shift-invert with complex shifts (points on the spectrum hull) is possible.
+For a Krylov space of dimension m, the k wanted Ritz values are kept and the m - k unwanted ones are used as
+exact shifts of implicit QR steps on the Hessenberg matrix, the factorization is then extended to m again.
+*/
+
+using ComplexVec = Eigen::VectorXcd;
+using ComplexMat = Eigen::MatrixXcd;
+
+// Reads a real matrix in coordinate Matrix Market format (general, symmetric or skew-symmetric)
+inline Eigen::SparseMatrix<double> read_MatrixMarket(const std::string FileName) {
+  std::ifstream File(FileName);
+  assert(File);
+
+  std::string line;
+  std::getline(File, line);
+  assert(line.rfind("%%MatrixMarket", 0) == 0 && line.find("coordinate") != std::string::npos);
+  assert(line.find("complex") == std::string::npos && line.find("pattern") == std::string::npos);
+  const bool Symmetric     = line.find(" symmetric") != std::string::npos;
+  const bool SkewSymmetric = line.find("skew-symmetric") != std::string::npos;
+
+  while(std::getline(File, line) && (line.empty() || line[0] == '%'))
+    continue;
+
+  long Rows, Cols, NumEntries;
+  std::stringstream(line) >> Rows >> Cols >> NumEntries;
+  assert(Rows == Cols);
+
+  std::vector<Eigen::Triplet<double>> Entries;
+  Entries.reserve((Symmetric || SkewSymmetric) ? 2 * NumEntries : NumEntries);
+  long i, j;
+  double Value;
+  for(long e = 0; e < NumEntries; e++) {
+    File >> i >> j >> Value;
+    Entries.emplace_back(i-1, j-1, Value);
+    if((Symmetric || SkewSymmetric) && i != j)
+      Entries.emplace_back(j-1, i-1, SkewSymmetric ? -Value : Value);
+  }
+  assert(File);
+
+  Eigen::SparseMatrix<double> A(Rows, Cols);
+  A.setFromTriplets(Entries.begin(), Entries.end()); // Duplicates are summed up
+  A.makeCompressed();
+
+  std::cout << "Read " << Rows << " x " << Cols << " matrix with " << A.nonZeros() << " non-zeros from "
+            << FileName << std::endl;
+  return A;
+}
+
+// Unit vector orthogonal to the first 'j' columns of 'V' (restart after breakdown, i.e., an invariant subspace)
+inline ComplexVec RandomOrthogonal(const ComplexMat& V, const int j, std::mt19937& Generator) {
+  std::normal_distribution<double> Normal;
+  ComplexVec w(V.rows());
+  for(Eigen::Index r = 0; r < w.size(); r++)
+    w(r) = Normal(Generator);
+  for(int Pass = 0; Pass < 2; Pass++)
+    w -= V.leftCols(j) * (V.leftCols(j).adjoint() * w);
+
+  return w / w.norm();
+}
+
+// Extends the Arnoldi factorization A V_j = V_j H_j + f e_j^T from 'j0' to 'm' columns (classical Gram-Schmidt, reorthogonalized)
+template <typename Operator>
+void ArnoldiExtend(const Operator& Op, ComplexMat& V, ComplexMat& H, const int j0, const int m, std::mt19937& Generator) {
+  ComplexVec w(V.rows());
+
+  for(int j = j0; j < m; j++) {
+    Op(V.col(j), w);
+
+    ComplexVec h = V.leftCols(j+1).adjoint() * w;
+    w -= V.leftCols(j+1) * h;
+    const ComplexVec Correction = V.leftCols(j+1).adjoint() * w;
+    w -= V.leftCols(j+1) * Correction;
+    h += Correction;
+
+    H.col(j).setZero();
+    H.block(0, j, j+1, 1) = h;
+    const double Beta = w.norm();
+    H(j+1, j) = Beta;
+
+    // Invariant subspace found: Continue with random vector orthogonal to the basis
+    if(Beta < 1e-12 * h.norm()) {
+      H(j+1, j) = 0.;
+      V.col(j+1) = RandomOrthogonal(V, j+1, Generator);
+    }
+    else
+      V.col(j+1) = w / Beta;
+  }
+}
+
+/*
+One run of IRAM with Krylov dimension 'm'. Returns the converged ones among the 'k' wanted Ritz values, sorted by 'Score'.
+The run ends early if the residuals stagnate.
+Once Ritz values converged, as many additional ones are kept in the restarts (at most half of the shifts, as in ARPACK),
+which keeps the converged Ritz vectors in the basis and speeds up convergence for clustered wanted eigenvalues.
+*/
+template <typename Operator, typename ScoreFunc>
+std::vector<std::complex<double>> IRAM_Run(const Operator& Op, const Eigen::Index N, const int k, const int m,
+                                           const ScoreFunc& Score, const double Tol, const int MaxRestarts,
+                                           std::mt19937& Generator, bool& ExtremeConverged) {
+  std::normal_distribution<double> Normal;
+
+  ComplexMat V(N, m+1);
+  ComplexMat H = ComplexMat::Zero(m+1, m);
+  for(Eigen::Index r = 0; r < N; r++)
+    V(r, 0) = Normal(Generator);
+  V.col(0).normalize();
+
+  ArnoldiExtend(Op, V, H, 0, m, Generator);
+
+  const int StagnationCheck = 25;
+  double MaxRelResidualCheck = 0.;
+  for(int Restart = 0; ; Restart++) {
+    ComplexMat Hm = H.topLeftCorner(m, m);
+    Eigen::ComplexEigenSolver<ComplexMat> Solver(Hm);
+    const ComplexVec Theta = Solver.eigenvalues();
+
+    std::vector<int> Order(m);
+    std::iota(Order.begin(), Order.end(), 0);
+    std::stable_sort(Order.begin(), Order.end(), [&](const int a, const int b) {
+      return Score(Theta(a)) > Score(Theta(b));
+    });
+
+    // Ritz residuals ||A V y - theta V y|| = |h_{m+1,m}| |e_m^T y|
+    std::vector<std::complex<double>> RitzValues;
+    double MaxRelResidual = 0.;
+    for(int i = 0; i < k; i++) {
+      const double RelResidual = std::abs(H(m, m-1)) * std::abs(Solver.eigenvectors()(m-1, Order[i]))
+                                 / std::max(std::abs(Theta(Order[i])), 1e-10);
+      if(RelResidual <= Tol)
+        RitzValues.push_back(Theta(Order[i]));
+      if(i == 0)
+        ExtremeConverged = !RitzValues.empty();
+      MaxRelResidual = std::max(MaxRelResidual, RelResidual);
+    }
+    const int NumConverged = RitzValues.size();
+    if(NumConverged == k || Restart == MaxRestarts)
+      return RitzValues;
+
+    // Stagnation: Residuals do not even halve over 'StagnationCheck' restarts => Krylov space too small
+    if(Restart % StagnationCheck == 0) {
+      if(Restart >= 2 * StagnationCheck && MaxRelResidual > 0.5 * MaxRelResidualCheck)
+        return RitzValues;
+      MaxRelResidualCheck = MaxRelResidual;
+    }
+
+    const int kKeep = std::min(k + std::min(NumConverged, (m - k) / 2), m - 1);
+
+    // Implicit QR steps with the unwanted Ritz values as exact shifts (bulge chasing with Givens rotations, O(m^2) each)
+    ComplexMat Q = ComplexMat::Identity(m, m);
+    for(int i = kKeep; i < m; i++) {
+      for(int j = 0; j < m - 1; j++) {
+        const std::complex<double> x = (j == 0) ? Hm(0, 0) - Theta(Order[i]) : Hm(j, j-1);
+        const std::complex<double> y = (j == 0) ? Hm(1, 0) : Hm(j+1, j-1);
+        Eigen::JacobiRotation<std::complex<double>> G;
+        G.makeGivens(x, y);
+
+        Hm.applyOnTheLeft(j, j+1, G.adjoint());
+        Hm.applyOnTheRight(j, j+1, G);
+        Q.applyOnTheRight(j, j+1, G);
+        if(j > 0)
+          Hm(j+1, j-1) = 0.; // Bulge removed
+      }
+    }
+
+    // Truncate to kKeep columns: f = V_m q_{kKeep+1} Hm(kKeep+1, kKeep) + f_m Q(m, kKeep)
+    const ComplexMat Vk = V.leftCols(m) * Q.leftCols(kKeep+1);
+    const ComplexVec f  = Vk.col(kKeep) * Hm(kKeep, kKeep-1) + V.col(m) * H(m, m-1) * Q(m-1, kKeep-1);
+
+    V.leftCols(kKeep) = Vk.leftCols(kKeep);
+    H.setZero();
+    H.topLeftCorner(kKeep, kKeep) = Hm.topLeftCorner(kKeep, kKeep);
+    const double Beta = f.norm();
+    // Invariant subspace found: As in 'ArnoldiExtend'
+    if(Beta < 1e-12 * H.topLeftCorner(kKeep, kKeep).norm()) {
+      H(kKeep, kKeep-1) = 0.;
+      V.col(kKeep) = RandomOrthogonal(V, kKeep, Generator);
+    }
+    else {
+      H(kKeep, kKeep-1) = Beta;
+      V.col(kKeep) = f / Beta;
+    }
+
+    ArnoldiExtend(Op, V, H, kKeep, m, Generator);
+  }
+}
+
+/*
+'NumWanted' eigenvalues of the operator 'Op' (y = Op(x)) of dimension 'N' with highest 'Score', e.g.
+|theta| for largest magnitude or -Re(theta) for most negative real part.
+Returns only Ritz values with converged residual, sorted by 'Score'. If not all of them converge within 'MaxRestarts',
+the Krylov dimension is doubled (up to 'MaxKrylovFactor' times 'KrylovDim'), since clustered eigenvalues
+(e.g. the end of the spectrum of a diffusion operator) need a larger Krylov space to be separated.
+'ExtremeConverged' tells whether the eigenvalue with highest 'Score' is among the converged ones.
+*/
+template <typename Operator, typename ScoreFunc>
+std::vector<std::complex<double>> IRAM(const Operator& Op, const Eigen::Index N, const int NumWanted,
+                                       const int KrylovDim, const ScoreFunc& Score,
+                                       const double Tol = 1e-8, const int MaxRestarts = 300,
+                                       bool* ExtremeConverged = NULL, const unsigned Seed = 42,
+                                       const int MaxKrylovFactor = 8) {
+  std::mt19937 Generator(Seed);
+  bool ExtremeConv = false;
+
+  for(int m = std::min<Eigen::Index>(KrylovDim, N); ; m = std::min<Eigen::Index>(2 * m, N)) {
+    const int k = std::min(NumWanted, m - 1);
+    assert(k >= 1);
+
+    const std::vector<std::complex<double>> RitzValues = IRAM_Run(Op, N, k, m, Score, Tol, MaxRestarts, Generator,
+                                                                  ExtremeConv);
+    if(ExtremeConverged)
+      *ExtremeConverged = ExtremeConv;
+    if(RitzValues.size() == static_cast<size_t>(k))
+      return RitzValues;
+
+    if(m == N || 2 * m > MaxKrylovFactor * KrylovDim) {
+      std::cout << "CARE: Only " << RitzValues.size() << " of " << k
+                << " Ritz values converged, returning only these!" << std::endl;
+      return RitzValues;
+    }
+    std::cout << RitzValues.size() << " of " << k << " Ritz values converged, Krylov dimension increased to "
+              << std::min<Eigen::Index>(2 * m, N) << std::endl;
+  }
+}
+
+// Largest magnitude, most negative real and largest imaginary parts of the sparse matrix 'A'.
+// Eigenvalues with largest real part close the hull towards the imaginary axis.
+// 'ExtentsFound' is false if for some target the extremal eigenvalue did not converge, i.e., the extent is unknown.
+inline std::vector<std::complex<double>> ExtremalEigVals(const Eigen::SparseMatrix<double>& A, const int NumWanted,
+                                                        const int KrylovDim, bool& ExtentsFound) {
+  const Eigen::SparseMatrix<std::complex<double>> Ac = A.cast<std::complex<double>>();
+  auto Op = [&](const ComplexVec& x, ComplexVec& y) { y = Ac * x; };
+
+  std::vector<std::complex<double>> EigVals;
+  const std::vector<std::function<double(const std::complex<double>&)>> Scores = {
+    [](const std::complex<double>& z) { return std::abs(z); },      // Largest magnitude
+    [](const std::complex<double>& z) { return -z.real(); },        // Most negative real part
+    [](const std::complex<double>& z) { return std::abs(z.imag()); }, // Largest imaginary part
+    [](const std::complex<double>& z) { return z.real(); }            // Largest real part
+  };
+  ExtentsFound = true;
+  for(const auto& Score : Scores) {
+    bool ExtremeConverged;
+    const std::vector<std::complex<double>> Ritz = IRAM(Op, A.rows(), NumWanted, KrylovDim, Score, 1e-8, 300,
+                                                        &ExtremeConverged);
+    EigVals.insert(EigVals.end(), Ritz.begin(), Ritz.end());
+    ExtentsFound = ExtentsFound && ExtremeConverged;
+  }
+  return EigVals;
+}
+
+// Eigenvalues of 'A' closest to the (complex) shift 'Sigma' by shift-invert: theta = 1 / (lambda - Sigma)
+inline std::vector<std::complex<double>> ShiftInvertEigVals(const Eigen::SparseMatrix<double>& A,
+                                                           const std::complex<double> Sigma,
+                                                           const int NumWanted, const int KrylovDim) {
+  Eigen::SparseMatrix<std::complex<double>> Shifted = A.cast<std::complex<double>>();
+  for(Eigen::Index i = 0; i < A.rows(); i++)
+    Shifted.coeffRef(i, i) -= Sigma;
+  Shifted.makeCompressed();
+
+  Eigen::SparseLU<Eigen::SparseMatrix<std::complex<double>>> LU;
+  LU.compute(Shifted);
+  if(LU.info() != Eigen::Success) { // Shift is (numerically) an eigenvalue
+    std::cout << "CARE: Factorization for shift " << Sigma << " failed" << std::endl;
+    return {};
+  }
+
+  auto Op = [&](const ComplexVec& x, ComplexVec& y) { y = LU.solve(x); };
+  auto LargestMagnitude = [](const std::complex<double>& z) { return std::abs(z); };
+
+  std::vector<std::complex<double>> EigVals = IRAM(Op, A.rows(), NumWanted, KrylovDim, LargestMagnitude);
+  for(std::complex<double>& Lambda : EigVals)
+    Lambda = Sigma + 1. / Lambda;
+
+  return EigVals;
+}
+
+/*
+Shifted variants along the hull: The extremal eigenvalues span a first upper convex hull, on which 'NumShifts'
+equidistant (in arc length) points are chosen as shifts. The eigenvalues closest to these shifts resolve the
+boundary of the spectrum between the extremal eigenvalues, i.e., where the hull of the extremal ones may cut corners.
+Shifts are moved off the hull by 'Offset' times the hull length into the left-upper half plane to avoid singular factorizations.
+*/
+inline std::vector<std::complex<double>> HullShiftEigVals(const Eigen::SparseMatrix<double>& A,
+                                                         const std::vector<std::complex<double>>& EigVals,
+                                                         const int NumShifts, const int NumWanted,
+                                                         const int KrylovDim, const double Offset = 1e-3) {
+  std::vector<std::complex<double>> Sorted = EigVals;
+  for(std::complex<double>& Lambda : Sorted)
+    Lambda = {Lambda.real(), std::abs(Lambda.imag())};
+  std::sort(Sorted.begin(), Sorted.end(), [](const std::complex<double>& a, const std::complex<double>& b) {
+    return a.real() < b.real() || (a.real() == b.real() && a.imag() < b.imag());
+  });
+
+  std::vector<double> Real, Imag, HullReal, HullImag;
+  for(const std::complex<double>& Lambda : Sorted) {
+    Real.push_back(Lambda.real());
+    Imag.push_back(Lambda.imag());
+  }
+  UpperConvexHull(Real, Imag, HullReal, HullImag);
+
+  std::vector<std::complex<double>> ShiftEigVals;
+  if(HullReal.size() < 2)
+    return ShiftEigVals;
+
+  const std::vector<double> ArcLengths = CurveArcLengths(HullReal, HullImag);
+  const double Length = ArcLengths.back();
+  for(int i = 0; i < NumShifts; i++) {
+    double SigmaReal, SigmaImag;
+    CurvePoint(Length * (i + 1) / (NumShifts + 1), ArcLengths, HullReal, HullImag, SigmaReal, SigmaImag);
+    const std::complex<double> Sigma(SigmaReal - Offset * Length, SigmaImag + Offset * Length);
+
+    std::cout << "Shift " << i + 1 << "/" << NumShifts << ": " << Sigma << std::endl;
+    const std::vector<std::complex<double>> Ritz = ShiftInvertEigVals(A, Sigma, NumWanted, KrylovDim);
+    ShiftEigVals.insert(ShiftEigVals.end(), Ritz.begin(), Ritz.end());
+  }
+  return ShiftEigVals;
+}
+
+#endif // __ARNOLDI_HPP__
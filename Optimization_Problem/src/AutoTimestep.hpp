@@ -0,0 +1,169 @@
+// This code is published under the Eclipse Public License.
+// If you have not obtained a copy of the EPL, you can find the license (version 2.0) at
+// https://www.eclipse.org/legal/epl-2.0/
+//
+// Authors:  Daniel Doehring                  RWTH Aachen University 2022-11-20
+
+#ifndef __AUTOTIMESTEP_HPP__
+#define __AUTOTIMESTEP_HPP__
+
+#include <string>
+#include <vector>
+#include <iostream>
+#include <random>
+#include <algorithm>
+#include <limits>
+#include <cmath>
+#include <cassert>
+#include <stdexcept>
+
+#include "IO_Funcs.hpp" // For 'read_EigVals'
+#include "Arnoldi.hpp"  // For 'read_MatrixMarket'
+
+/*
+Reference timestep without a separate experiment: Pass 'auto' (spectrum) or 'auto:Jacobian.mtx' (sparse operator)
+instead of 'dtRef'. The expected timestep of the S stage method is estimated as
+
+  dtExp = min(RealExtent(S, p) / max |Re lambda|, ImagExtent(S, p) / max |Im lambda|)
+
+with the extents of stability regions of optimized polynomials along the negative real axis, c_p S^2
+(c_p asymptotic, e.g., Chebyshev for p = 1, ROCK2/ROCK4 for p = 2/4), and along the imaginary axis, S - 1 for p <= 3
+(Kinnmark & Gray) and sqrt((S-1)^2 - 1) for p = 4.
+This tends to overestimate the optimal timestep slightly, which is intended since the timestep is bounded by 1.1 dtExp.
+For the operator, max |Re lambda| and max |Im lambda| are bounded by the spectral radii of its (skew-)symmetric parts
+and of the operator itself, all obtained by power iteration. For non-normal operators this may underestimate dtExp.
+dtRef is then chosen such that dtExp = (dtRef / NumStagesRef) * S.
+*/
+
+// Exactly 'auto' or 'auto:<file>'
+inline bool is_AutoRef(const std::string& dtRefArg) {
+  return dtRefArg == "auto" || dtRefArg.rfind("auto:", 0) == 0;
+}
+
+inline void StabRegionExtents(const int NumStages, const int ConsOrder, double& RealExtent, double& ImagExtent) {
+  const double RealFactor[4] = {2., 0.82, 0.49, 0.35};
+  assert(ConsOrder >= 1 && ConsOrder <= 4);
+
+  RealExtent = RealFactor[ConsOrder - 1] * NumStages * NumStages;
+  ImagExtent = (ConsOrder <= 3) ? NumStages - 1. : std::sqrt(std::max((NumStages - 1.) * (NumStages - 1.) - 1., 0.));
+}
+
+inline double auto_dtExp(const int NumStages, const int ConsOrder, const double MaxAbsReal, const double MaxAbsImag) {
+  double RealExtent, ImagExtent;
+  StabRegionExtents(NumStages, ConsOrder, RealExtent, ImagExtent);
+
+  double dtExp = std::numeric_limits<double>::infinity();
+  if(MaxAbsReal > 0)
+    dtExp = std::min(dtExp, RealExtent / MaxAbsReal);
+  if(MaxAbsImag > 0 && ImagExtent > 0)
+    dtExp = std::min(dtExp, ImagExtent / MaxAbsImag);
+  assert(std::isfinite(dtExp));
+
+  return dtExp;
+}
+
+/*
+Spectral radius by power iteration. Since a dominant complex pair (real operator) does not yield a converging
+Rayleigh quotient, the average growth rate ||A^k x||^(1/(k - k0)) over the second half of the iterations is used.
+*/
+template <typename Operator>
+double SpectralRadius(const Operator& Op, const Eigen::Index N, const double Tol = 1e-3, const int MaxIter = 2000) {
+  std::mt19937 Generator(42);
+  std::normal_distribution<double> Normal;
+
+  Eigen::VectorXd x(N), y(N);
+  for(Eigen::Index i = 0; i < N; i++)
+    x(i) = Normal(Generator);
+  x.normalize();
+
+  // log ||A^k x_0|| for all k
+  std::vector<double> LogNorms = {0.};
+  double Radius = 0.;
+  for(int k = 1; k <= MaxIter; k++) {
+    Op(x, y);
+    const double Norm = y.norm();
+    if(Norm == 0.)
+      return 0.;
+    LogNorms.push_back(LogNorms.back() + std::log(Norm));
+    x = y / Norm;
+
+    if(k % 20 == 0) {
+      const double RadiusNew = std::exp((LogNorms[k] - LogNorms[k/2]) / (k - k/2));
+      if(std::abs(RadiusNew - Radius) <= Tol * RadiusNew)
+        return RadiusNew;
+      Radius = RadiusNew;
+    }
+  }
+  std::cout << "CARE: Power iteration did not converge!" << std::endl;
+  return Radius;
+}
+
+inline void OperatorExtents(const std::string MatrixFileName, double& MaxAbsReal, double& MaxAbsImag) {
+  const Eigen::SparseMatrix<double> A = read_MatrixMarket(MatrixFileName);
+  const Eigen::SparseMatrix<double> At = A.transpose();
+  const Eigen::SparseMatrix<double> Sym  = 0.5 * (A + At);
+  const Eigen::SparseMatrix<double> Skew = 0.5 * (A - At);
+
+  const double Radius = SpectralRadius([&](const Eigen::VectorXd& x, Eigen::VectorXd& y) { y = A * x; }, A.rows());
+  // Re lambda in field of values of the symmetric part, Im lambda in that of the skew-symmetric part
+  const double RadiusSym  = SpectralRadius([&](const Eigen::VectorXd& x, Eigen::VectorXd& y) { y = Sym * x; }, A.rows());
+  const double RadiusSkew = SpectralRadius([&](const Eigen::VectorXd& x, Eigen::VectorXd& y) { y = Skew * x; }, A.rows());
+
+  std::cout << "Spectral radius of operator, symmetric and skew-symmetric part: "
+            << Radius << ", " << RadiusSym << ", " << RadiusSkew << std::endl;
+  MaxAbsReal = std::min(Radius, RadiusSym);
+  MaxAbsImag = std::min(Radius, RadiusSkew);
+}
+
+template <typename T>
+void SpectrumExtents(const std::vector<T>& RealEigVals, const std::vector<T>& ImagEigVals,
+                     double& MaxAbsReal, double& MaxAbsImag) {
+  MaxAbsReal = 0.;
+  MaxAbsImag = 0.;
+  for(size_t i = 0; i < RealEigVals.size(); i++) {
+    MaxAbsReal = std::max(MaxAbsReal, static_cast<double>(std::abs(RealEigVals[i])));
+    MaxAbsImag = std::max(MaxAbsImag, static_cast<double>(std::abs(ImagEigVals[i])));
+  }
+}
+
+// dtRef for the given extents such that dtExp of the S stage method matches the estimate
+inline double auto_dtRef(const int NumStages, const int ConsOrder, const int NumStagesRef,
+                         const double MaxAbsReal, const double MaxAbsImag) {
+  const double dtExp = auto_dtExp(NumStages, ConsOrder, MaxAbsReal, MaxAbsImag);
+  std::cout << "Estimated timestep of the " << NumStages << " stage method: " << dtExp
+            << " (max |Re|: " << MaxAbsReal << ", max |Im|: " << MaxAbsImag << ")" << std::endl << std::endl;
+
+  return dtExp * NumStagesRef / NumStages;
+}
+
+// 'dtRefArg' is either a number, 'auto' (estimate from the spectrum 'EigValFileName') or 'auto:Jacobian.mtx'
+inline double parse_dtRef(const std::string dtRefArg, const std::string EigValFileName,
+                          const int NumStages, const int ConsOrder, const int NumStagesRef) {
+  if(!is_AutoRef(dtRefArg)) {
+    // Reject trailing characters (e.g. misspelled 'auto'), which 'std::stod' alone would accept or ignore
+    size_t NumParsed = 0;
+    double dtRef = std::numeric_limits<double>::quiet_NaN();
+    try { dtRef = std::stod(dtRefArg, &NumParsed); } catch(const std::exception&) {}
+    if(NumParsed != dtRefArg.size() || !(dtRef > 0.))
+      throw std::invalid_argument("dt_ref must be a positive number, 'auto' or 'auto:<Jacobian.mtx>', got '" + 
+                                  dtRefArg + "'");
+    return dtRef;
+  }
+
+  double MaxAbsReal, MaxAbsImag;
+  if(dtRefArg != "auto") {
+    if(dtRefArg.size() == 5)
+      throw std::invalid_argument("dt_ref 'auto:' requires a matrix file, e.g. 'auto:Jacobian.mtx'");
+    OperatorExtents(dtRefArg.substr(5), MaxAbsReal, MaxAbsImag);
+  }
+  else {
+    int NumEigVals;
+    std::vector<double> RealEigVals, ImagEigVals;
+    read_EigVals(EigValFileName, NumEigVals, RealEigVals, ImagEigVals);
+    SpectrumExtents(RealEigVals, ImagEigVals, MaxAbsReal, MaxAbsImag);
+  }
+
+  return auto_dtRef(NumStages, ConsOrder, NumStagesRef, MaxAbsReal, MaxAbsImag);
+}
+
+#endif // __AUTOTIMESTEP_HPP__
@@ -0,0 +1,117 @@
+// This code is published under the Eclipse Public License.
+// If you have not obtained a copy of the EPL, you can find the license (version 2.0) at
+// https://www.eclipse.org/legal/epl-2.0/
+//
+// Authors:  Daniel Doehring                  RWTH Aachen University 2022-11-20
+
+#ifndef __CHECKPOINT_HPP__
+#define __CHECKPOINT_HPP__
+
+#include <string>
+#include <vector>
+#include <fstream>
+#include <cstdio>
+#include <cstdint>
+#include <cstring>
+
+/*
+Checkpoints of long optimizations, written periodically from 'intermediate_callback'.
+Layout: Magic (8 bytes), problem signature (uint64), Iter, n, m (int64), barrier parameter mu (double),
+        x, z_L, z_U (n doubles each), lambda (m doubles),
+        best iterate x, z_L, z_U (n doubles each), lambda (m doubles), 
+        objective and infeasibility of the best iterate (2 doubles).
+The signature (see 'ProblemSignature') is checked on resume, such that a changed problem starts from scratch.
+Written to a temporary file which is then renamed, such that a killed job never leaves a partial checkpoint.
+*/
+
+struct Checkpoint {
+  uint64_t Signature;
+  int64_t Iter;
+  double mu;
+  std::vector<double> x, zL, zU, lambda;
+  std::vector<double> xBest, zLBest, zUBest, lambdaBest;
+  double BestObj, BestInfPr;
+};
+
+static const char CheckpointMagic[8] = {'O', 'S', 'P', 'R', 'E', 'I', 'C', '2'};
+
+inline bool write_Checkpoint(const std::string FileName, const Checkpoint& State) {
+  const std::string TempFileName = FileName + ".tmp";
+  std::ofstream File(TempFileName, std::ios::binary);
+  const int64_t n = State.x.size(), m = State.lambda.size();
+
+  File.write(CheckpointMagic, sizeof(CheckpointMagic));
+  File.write(reinterpret_cast<const char*>(&State.Signature), sizeof(State.Signature));
+  File.write(reinterpret_cast<const char*>(&State.Iter), sizeof(State.Iter));
+  File.write(reinterpret_cast<const char*>(&n), sizeof(n));
+  File.write(reinterpret_cast<const char*>(&m), sizeof(m));
+  File.write(reinterpret_cast<const char*>(&State.mu), sizeof(State.mu));
+  File.write(reinterpret_cast<const char*>(State.x.data()),      n * sizeof(double));
+  File.write(reinterpret_cast<const char*>(State.zL.data()),     n * sizeof(double));
+  File.write(reinterpret_cast<const char*>(State.zU.data()),     n * sizeof(double));
+  File.write(reinterpret_cast<const char*>(State.lambda.data()), m * sizeof(double));
+  File.write(reinterpret_cast<const char*>(State.xBest.data()),      n * sizeof(double));
+  File.write(reinterpret_cast<const char*>(State.zLBest.data()),     n * sizeof(double));
+  File.write(reinterpret_cast<const char*>(State.zUBest.data()),     n * sizeof(double));
+  File.write(reinterpret_cast<const char*>(State.lambdaBest.data()), m * sizeof(double));
+  File.write(reinterpret_cast<const char*>(&State.BestObj),   sizeof(double));
+  File.write(reinterpret_cast<const char*>(&State.BestInfPr), sizeof(double));
+  File.close();
+
+  if(!File)
+    return false;
+  // Atomic replacement of the previous checkpoint (POSIX)
+  return std::rename(TempFileName.c_str(), FileName.c_str()) == 0;
+}
+
+// Returns false if the file does not exist, is corrupted or does not match the problem size:
+// 'NumUnknowns' unknowns and at most 'MaxNumConstr' constraints (fewer with aggregated stability constraints)
+inline bool read_Checkpoint(const std::string FileName, Checkpoint& State, 
+                            const int64_t NumUnknowns, const int64_t MaxNumConstr) {
+  std::ifstream File(FileName, std::ios::binary | std::ios::ate);
+  if(!File)
+    return false;
+  const uint64_t FileSize = File.tellg();
+  File.seekg(0);
+
+  char Magic[sizeof(CheckpointMagic)];
+  int64_t n, m;
+  File.read(Magic, sizeof(Magic));
+  File.read(reinterpret_cast<char*>(&State.Signature), sizeof(State.Signature));
+  File.read(reinterpret_cast<char*>(&State.Iter), sizeof(State.Iter));
+  File.read(reinterpret_cast<char*>(&n), sizeof(n));
+  File.read(reinterpret_cast<char*>(&m), sizeof(m));
+  File.read(reinterpret_cast<char*>(&State.mu), sizeof(State.mu));
+  if(!File || std::memcmp(Magic, CheckpointMagic, sizeof(Magic)) != 0)
+    return false;
+
+  // Check the stored sizes before allocating
+  const uint64_t HeaderSize = sizeof(CheckpointMagic) + sizeof(State.Signature) + sizeof(State.Iter) + 
+                              sizeof(n) + sizeof(m) + sizeof(State.mu);
+  if(n != NumUnknowns || m < 0 || m > MaxNumConstr || 
+     FileSize != HeaderSize + (6 * n + 2 * m + 2) * sizeof(double))
+    return false;
+
+  State.x.resize(n);
+  State.zL.resize(n);
+  State.zU.resize(n);
+  State.lambda.resize(m);
+  State.xBest.resize(n);
+  State.zLBest.resize(n);
+  State.zUBest.resize(n);
+  State.lambdaBest.resize(m);
+  File.read(reinterpret_cast<char*>(State.x.data()),      n * sizeof(double));
+  File.read(reinterpret_cast<char*>(State.zL.data()),     n * sizeof(double));
+  File.read(reinterpret_cast<char*>(State.zU.data()),     n * sizeof(double));
+  File.read(reinterpret_cast<char*>(State.lambda.data()), m * sizeof(double));
+  File.read(reinterpret_cast<char*>(State.xBest.data()),      n * sizeof(double));
+  File.read(reinterpret_cast<char*>(State.zLBest.data()),     n * sizeof(double));
+  File.read(reinterpret_cast<char*>(State.zUBest.data()),     n * sizeof(double));
+  File.read(reinterpret_cast<char*>(State.lambdaBest.data()), m * sizeof(double));
+  File.read(reinterpret_cast<char*>(&State.BestObj),   sizeof(double));
+  File.read(reinterpret_cast<char*>(&State.BestInfPr), sizeof(double));
+
+  return static_cast<bool>(File);
+}
+
+#endif
@@ -13,62 +13,381 @@
 #include <fstream>
 #include <cassert>
 #include <sstream>
+#include <cmath>
+#include <unordered_map>
+#include <algorithm>
+#include <charconv>
+#include <chrono>
+#include <cstring>
+#include <cctype>
+#include <utility>
+#include <thread>
 
+#include "SpectrumBinary.hpp"
+
+// Parses a number at 'First', skipping leading blanks and a leading '+' (not accepted by 'from_chars')
+inline const char* parse_Number(const char* First, const char* Last, double& Value) {
+  while(First < Last && (*First == ' ' || *First == '\t'))
+    First++;
+  if(First < Last && *First == '+')
+    First++;
+
+  const std::from_chars_result Result = std::from_chars(First, Last, Value);
+  return (Result.ec == std::errc()) ? Result.ptr : NULL;
+}
+
+// One thread per MiB of input, at most one per hardware thread
+inline size_t NumParseThreads(const size_t Bytes) {
+  const size_t HardwareThreads = std::max(std::thread::hardware_concurrency(), 1u);
+  return std::max(std::min(HardwareThreads, Bytes >> 20), (size_t) 1);
+}
+
+inline std::string read_File(const std::string FileName) {
+  std::ifstream File(FileName, std::ios::binary | std::ios::ate);
+  assert(File);
+  const size_t FileSize = File.tellg();
+  std::string Buffer(FileSize, '\0');
+  File.seekg(0);
+  File.read(&Buffer[0], FileSize);
+  return Buffer;
+}
+
+// Bounds of (at most) 'NumChunks' pieces of [Begin, End), each ending with a line break (except the last one)
+inline std::vector<const char*> split_Lines(const char* Begin, const char* End, const size_t NumChunks) {
+  std::vector<const char*> Bounds = {Begin};
+  for(size_t k = 1; k < NumChunks; k++) {
+    const char* Target = std::max(Begin + (End - Begin) * k / NumChunks, Bounds.back());
+    const char* LineEnd = static_cast<const char*>(std::memchr(Target, '\n', End - Target));
+    if(LineEnd == NULL)
+      break;
+    if(LineEnd + 1 > Bounds.back())
+      Bounds.push_back(LineEnd + 1);
+  }
+  Bounds.push_back(End);
+  return Bounds;
+}
+
+// Calls 'Func(k)' for k = 0, ..., NumTasks - 1 on one thread each (serial for a single task)
+template <typename Func>
+void run_Parallel(const size_t NumTasks, Func&& Task) {
+  if(NumTasks == 1) {
+    Task(0);
+    return;
+  }
+  std::vector<std::thread> Threads;
+  for(size_t k = 0; k < NumTasks; k++)
+    Threads.emplace_back(Task, k);
+  for(std::thread& Thread : Threads)
+    Thread.join();
+}
+
+// Stable sort: Sorted pieces are merged pairwise. Thus, the result does not depend on the number of threads.
+template <typename Elem, typename Compare>
+void parallel_stable_sort(std::vector<Elem>& V, Compare Comp, const size_t NumThreads) {
+  const size_t NumPieces = std::max(std::min(NumThreads, V.size()), (size_t) 1);
+  std::vector<size_t> Bounds(NumPieces + 1);
+  for(size_t k = 0; k <= NumPieces; k++)
+    Bounds[k] = V.size() * k / NumPieces;
+
+  run_Parallel(NumPieces, [&](const size_t k) {
+    std::stable_sort(V.begin() + Bounds[k], V.begin() + Bounds[k+1], Comp);
+  });
+
+  for(size_t Width = 1; Width < NumPieces; Width *= 2) {
+    const size_t NumMerges = (NumPieces + 2*Width - 1) / (2*Width);
+    run_Parallel(NumMerges, [&](const size_t m) {
+      const size_t First = Bounds[2*Width*m];
+      const size_t Mid   = Bounds[std::min(2*Width*m + Width, NumPieces)];
+      const size_t Last  = Bounds[std::min(2*Width*m + 2*Width, NumPieces)];
+      std::inplace_merge(V.begin() + First, V.begin() + Mid, V.begin() + Last, Comp);
+    });
+  }
+}
+
+inline bool RealPartLess(const std::pair<double, double>& a, const std::pair<double, double>& b) {
+  return (a.first < b.first);
+}
+
+// Sorts eigenvalues with ascending real part (stable, in parallel for large spectra)
 template <typename T>
-void read_EigVals(const std::string EigValFileName, int& NumEigVals,
-                  std::vector<T>& RealEigVals, std::vector<T>& ImagEigVals) {
-  int i = 0;
-  std::ifstream EigValsFile(EigValFileName);
-  assert(EigValsFile);
-  std::string line;
-  while (std::getline(EigValsFile, line))
-    i++;
-  EigValsFile.close();
+void sort_EigVals(std::vector<T>& RealEigVals, std::vector<T>& ImagEigVals) {
+  std::vector<std::pair<T, T>> EigVals(RealEigVals.size());
+  for(size_t i = 0; i < EigVals.size(); i++)
+    EigVals[i] = {RealEigVals[i], ImagEigVals[i]};
 
-  NumEigVals = i; // This is the number cones (and also number of inequalities)
-  std::cout << "Number of Eigenvalues is: " << NumEigVals << std::endl << std::endl;
+  parallel_stable_sort(EigVals, [](const std::pair<T, T>& a, const std::pair<T, T>& b) { return a.first < b.first; },
+                       NumParseThreads(16 * EigVals.size()));
 
+  for(size_t i = 0; i < EigVals.size(); i++) {
+    RealEigVals[i] = EigVals[i].first;
+    ImagEigVals[i] = EigVals[i].second;
+  }
+}
+
+// Eigenvalues of the lines [Curr, End)
+struct EigValChunk {
+  std::vector<std::pair<double, double>> EigVals;
+  size_t NumLines = 0, ErrorLine = 0; // 'ErrorLine' (1-based within chunk): First line which could not be parsed
+  size_t NumPositive = 0, NumNegImag = 0;
+};
+
+inline void parse_EigVal_Lines(const char* Curr, const char* End, EigValChunk& Chunk) {
+  Chunk.EigVals.reserve(std::count(Curr, End, '\n') + 1);
+
+  while(Curr < End) {
+    const char* LineEnd = static_cast<const char*>(std::memchr(Curr, '\n', End - Curr));
+    if(LineEnd == NULL)
+      LineEnd = End;
+    Chunk.NumLines++;
+
+    // Skip blank lines (also '\r' of Windows line endings)
+    const char* First = Curr;
+    while(First < LineEnd && std::isspace(static_cast<unsigned char>(*First)))
+      First++;
+
+    if(First < LineEnd) {
+      double real, imag;
+      const char* Pos = parse_Number(First, LineEnd, real);
+      if(Pos != NULL) {
+        // Separator '+' (or '-'), see 'read_EigVals'
+        while(Pos < LineEnd && (*Pos == ' ' || *Pos == '\t'))
+          Pos++;
+        Pos = (Pos < LineEnd) ? parse_Number(Pos + 1, LineEnd, imag) : NULL;
+      }
+      if(Pos == NULL) {
+        if(Chunk.ErrorLine == 0)
+          Chunk.ErrorLine = Chunk.NumLines;
+      }
+      else {
+        Chunk.NumPositive += (real > 0);
+        Chunk.NumNegImag  += (imag < 0);
+        Chunk.EigVals.emplace_back(real, imag);
+      }
+    }
+    Curr = LineEnd + 1;
+  }
+}
+
+// Eigenvalues of a binary spectrum, sorted unless already stored sorted
+template <typename T>
+void read_EigVals_Binary(const std::string EigValFileName, int& NumEigVals,
+                         std::vector<T>& RealEigVals, std::vector<T>& ImagEigVals) {
+  const auto Start = std::chrono::steady_clock::now();
+
+  const MappedSpectrum Spectrum(EigValFileName);
+  assert(Spectrum.valid());
+
+  NumEigVals = Spectrum.Header->NumEigVals;
+  std::cout << "Number of Eigenvalues is: " << NumEigVals << " (binary)" << std::endl;
+
+  const double Scaling = Spectrum.Header->Scaling;
   RealEigVals.resize(NumEigVals);
   ImagEigVals.resize(NumEigVals);
-  T real, imag;
+  for (int i = 0 ; i != NumEigVals ; i++) {
+    RealEigVals[i] = Scaling * Spectrum.EigVals[2*i];
+    ImagEigVals[i] = Scaling * Spectrum.EigVals[2*i + 1];
+  }
 
-  char plus;
-  i = 0;
-  EigValsFile.open(EigValFileName);
-  while (std::getline(EigValsFile, line)) {
-    std::stringstream stream(line);
-    assert(i < NumEigVals);
-    while (stream >> real >> plus >> imag) {
-      if(real > 0)
-        std::cout << "CARE: Eigenvalue with positive real part, should be removed!" << std::endl;
-      RealEigVals[i] = real;
+  if(!(Spectrum.Header->Flags & SpectrumSorted))
+    sort_EigVals(RealEigVals, ImagEigVals);
+
+  const double Seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - Start).count();
+  std::cout << "Mapped " << EigValFileName << " in " << Seconds << " s" << std::endl << std::endl;
+}
+
+// Hull block of a binary spectrum 'Spectrum.bin', requested as 'Spectrum.bin_real.txt' or 'Spectrum.bin_imag.txt'.
+// Returns false if 'Hull_FileName' does not refer to a binary spectrum.
+template <typename T>
+bool read_Hull_Binary(const std::string Hull_FileName, std::vector<T>& hull) {
+  const size_t Suffix = std::string("_real.txt").size();
+  if(Hull_FileName.size() <= Suffix)
+    return false;
+
+  const std::string Component = Hull_FileName.substr(Hull_FileName.size() - Suffix);
+  const std::string SpectrumFileName = Hull_FileName.substr(0, Hull_FileName.size() - Suffix);
+  if((Component != "_real.txt" && Component != "_imag.txt") || !is_BinarySpectrum(SpectrumFileName))
+    return false;
+
+  const MappedSpectrum Spectrum(SpectrumFileName);
+  assert(Spectrum.valid());
+  if(Spectrum.Header->NumHull == 0)
+    std::cout << "CARE: Binary spectrum " << SpectrumFileName << " contains no hull!" << std::endl;
+
+  const int Offset = (Component == "_real.txt") ? 0 : 1;
+  for(size_t i = 0; i < Spectrum.Header->NumHull; i++)
+    hull.push_back(Spectrum.Header->Scaling * Spectrum.Hull[2*i + Offset]);
+
+  return true;
+}
+
+// Reads eigenvalues 'a+bi', one per line, sorted with ascending real part.
+// The file is read at once and large files are parsed in chunks on all cores. The sign
+// separating real and imaginary part is not interpreted ('a+-bi' for negative imaginary parts).
+template <typename T>
+void read_EigVals(const std::string EigValFileName, int& NumEigVals,
+                  std::vector<T>& RealEigVals, std::vector<T>& ImagEigVals) {
+  // Binary spectrum (see 'SpectrumBinary.hpp')
+  if(is_BinarySpectrum(EigValFileName)) {
+    read_EigVals_Binary(EigValFileName, NumEigVals, RealEigVals, ImagEigVals);
+    return;
+  }
+
+  const auto Start = std::chrono::steady_clock::now();
+
+  const std::string Buffer = read_File(EigValFileName);
+  const size_t FileSize    = Buffer.size();
 
-      if(imag < 0)
-        std::cout << "CARE: Eigenvalue with negative imag part, should be removed!" << std::endl;
-      ImagEigVals[i] = imag;
+  // Chunks end with line breaks => Concatenation in chunk order equals the serial result
+  const size_t NumThreads = NumParseThreads(FileSize);
+  const std::vector<const char*> Bounds = split_Lines(Buffer.data(), Buffer.data() + FileSize, NumThreads);
+  std::vector<EigValChunk> Chunks(Bounds.size() - 1);
+  run_Parallel(Chunks.size(), [&](const size_t k) {
+    parse_EigVal_Lines(Bounds[k], Bounds[k+1], Chunks[k]);
+  });
+
+  size_t NumTotal = 0, NumLines = 0, NumPositive = 0, NumNegImag = 0;
+  for(const EigValChunk& Chunk : Chunks) {
+    if(Chunk.ErrorLine > 0) {
+      std::cout << "CARE: Could not parse line " << NumLines + Chunk.ErrorLine << " of " << EigValFileName << std::endl;
+      assert(false);
     }
-    i++;
+    NumTotal    += Chunk.EigVals.size();
+    NumLines    += Chunk.NumLines;
+    NumPositive += Chunk.NumPositive;
+    NumNegImag  += Chunk.NumNegImag;
+  }
+  if(NumPositive > 0)
+    std::cout << "CARE: " << NumPositive << " eigenvalues with positive real part, should be removed!" << std::endl;
+  if(NumNegImag > 0)
+    std::cout << "CARE: " << NumNegImag << " eigenvalues with negative imag part, should be removed!" << std::endl;
+
+  std::vector<std::pair<double, double>> EigVals;
+  EigVals.reserve(NumTotal);
+  for(EigValChunk& Chunk : Chunks) {
+    EigVals.insert(EigVals.end(), Chunk.EigVals.begin(), Chunk.EigVals.end());
+    std::vector<std::pair<double, double>>().swap(Chunk.EigVals);
   }
-  EigValsFile.close();
-  
+  const double ParseSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - Start).count();
+
+  NumEigVals = EigVals.size(); // This is the number cones (and also number of inequalities)
+  std::cout << "Number of Eigenvalues is: " << NumEigVals << std::endl;
+
   // Sort eigenvalues with asceding real part
-  std::vector<int> index(RealEigVals.size(), 0);
-  for (int i = 0 ; i != index.size() ; i++) {
-    index[i] = i;
+  parallel_stable_sort(EigVals, RealPartLess, NumThreads);
+
+  RealEigVals.resize(NumEigVals);
+  ImagEigVals.resize(NumEigVals);
+  for (int i = 0 ; i != NumEigVals ; i++) {
+    RealEigVals[i] = EigVals[i].first;
+    ImagEigVals[i] = EigVals[i].second;
+  }
+
+  const double Seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - Start).count();
+  std::cout << "Read " << FileSize / 1e6 << " MB on " << Chunks.size() << " thread(s) in " << Seconds << " s (parsing " 
+            << ParseSeconds << " s, " << FileSize / 1e6 / std::max(ParseSeconds, 1e-9) << " MB/s)" << std::endl << std::endl;
+}
+
+// Merge (near-)duplicate eigenvalues, i.e., eigenvalues which differ in real and imaginary part by at most 'Tol'.
+// The first eigenvalue of every cluster is kept (preserves sorting), 'Multiplicity' (optional) holds the cluster sizes.
+// Spatial hash on (Re, Im) buckets of width 'Tol' => Linear (expected) runtime.
+template <typename T>
+void dedup_EigVals(std::vector<T>& RealEigVals, std::vector<T>& ImagEigVals, T Tol, 
+                   std::vector<int>* Multiplicity = NULL) {
+  // Bucket indices |lambda|/Tol have to fit into long long (with margin for the neighbor lookup)
+  T MaxAbs = 0.;
+  for(size_t i = 0; i < RealEigVals.size(); i++)
+    MaxAbs = std::max(MaxAbs, std::max(std::abs(RealEigVals[i]), std::abs(ImagEigVals[i])));
+  const T MinTol = MaxAbs * std::ldexp(1., -60);
+  if(Tol < MinTol) {
+    std::cout << "CARE: Deduplication tolerance " << Tol << " below " << MinTol 
+              << " (max. |lambda| * 2^-60), use the latter!" << std::endl;
+    Tol = MinTol;
   }
-  std::sort(index.begin(), index.end(),
-      [&](const int& a, const int& b) {
-          return (RealEigVals[a] < RealEigVals[b]);
+
+  struct BucketHash {
+    size_t operator()(const std::pair<long long, long long>& Bucket) const {
+      return std::hash<long long>()(Bucket.first) ^ (std::hash<long long>()(Bucket.second) * 0x9e3779b97f4a7c15ULL);
+    }
+  };
+  // Buckets are smaller than 'Tol' => At most one representative per bucket
+  std::unordered_map<std::pair<long long, long long>, int, BucketHash> Representatives;
+  Representatives.reserve(RealEigVals.size());
+
+  if(Multiplicity)
+    Multiplicity->clear();
+
+  int NumReps = 0;
+  for(size_t i = 0; i < RealEigVals.size(); i++) {
+    const long long BucketRe = std::floor(RealEigVals[i] / Tol);
+    const long long BucketIm = std::floor(ImagEigVals[i] / Tol);
+
+    bool Merged = false;
+    for(long long dRe = -1; dRe <= 1 && !Merged; dRe++)
+      for(long long dIm = -1; dIm <= 1 && !Merged; dIm++) {
+        const auto it = Representatives.find({BucketRe + dRe, BucketIm + dIm});
+        if(it != Representatives.end() && 
+           std::abs(RealEigVals[it->second] - RealEigVals[i]) <= Tol && 
+           std::abs(ImagEigVals[it->second] - ImagEigVals[i]) <= Tol) {
+          Merged = true;
+          if(Multiplicity)
+            (*Multiplicity)[it->second]++;
+        }
       }
-  );
 
-  std::vector<T> RealEigVals_unsorted = RealEigVals;
-  std::vector<T> ImagEigVals_unsorted = ImagEigVals;
+    if(!Merged) { // New cluster: Compact in place
+      RealEigVals[NumReps] = RealEigVals[i];
+      ImagEigVals[NumReps] = ImagEigVals[i];
+      Representatives.emplace(std::make_pair(BucketRe, BucketIm), NumReps);
+      if(Multiplicity)
+        Multiplicity->push_back(1);
+      NumReps++;
+    }
+  }
+  RealEigVals.resize(NumReps);
+  ImagEigVals.resize(NumReps);
+}
+
+// Summary of the cluster sizes returned by 'dedup_EigVals'
+inline void report_Multiplicity(const std::vector<int>& Multiplicity) {
+  int NumClusters = 0, MaxMultiplicity = 1;
+  size_t MaxInd = 0;
+  for(size_t i = 0; i < Multiplicity.size(); i++) {
+    if(Multiplicity[i] > 1)
+      NumClusters++;
+    if(Multiplicity[i] > MaxMultiplicity) {
+      MaxMultiplicity = Multiplicity[i];
+      MaxInd = i;
+    }
+  }
+  std::cout << NumClusters << " eigenvalue(s) represent merged clusters";
+  if(NumClusters > 0)
+    std::cout << ", largest multiplicity " << MaxMultiplicity << " (eigenvalue " << MaxInd << ")";
+  std::cout << std::endl;
+}
+
+// Same as above, but with optional merging of (near-)duplicate eigenvalues (for 'DedupTol' > 0).
+// 'Multiplicity' (optional): Number of merged eigenvalues per kept eigenvalue (all ones without merging)
+template <typename T>
+void read_EigVals(const std::string EigValFileName, int& NumEigVals,
+                  std::vector<T>& RealEigVals, std::vector<T>& ImagEigVals,
+                  const T DedupTol, std::vector<int>* Multiplicity = NULL) {
+  read_EigVals(EigValFileName, NumEigVals, RealEigVals, ImagEigVals);
+
+  if(DedupTol > 0) {
+    std::vector<int> Counts;
+    dedup_EigVals(RealEigVals, ImagEigVals, DedupTol, &Counts);
 
-  for (int i = 0 ; i != index.size() ; i++) {
-    RealEigVals[i] = RealEigVals_unsorted[index[i]];
-    ImagEigVals[i] = ImagEigVals_unsorted[index[i]];
+    std::cout << "Merged (near-)duplicate eigenvalues with tolerance " << DedupTol << ": " 
+              << NumEigVals << " -> " << RealEigVals.size() << " eigenvalues" << std::endl;
+    report_Multiplicity(Counts);
+    std::cout << std::endl;
+    NumEigVals = RealEigVals.size();
+
+    if(Multiplicity)
+      *Multiplicity = Counts;
   }
+  else if(Multiplicity)
+    Multiplicity->assign(NumEigVals, 1);
 }
 
 template <typename T>
@@ -93,18 +412,39 @@ void read_x0(const std::string x0_FileName, std::vector<T>& x0, const int NumUnk
 
 template <typename T>
 void read_Hull(const std::string Hull_FileName, std::vector<T>& hull) {
-  std::ifstream Hull_File(Hull_FileName);
-  assert(Hull_File);
-  std::string line;
-  T point;
+  if(read_Hull_Binary(Hull_FileName, hull))
+    return;
 
-  while (std::getline(Hull_File, line)) {
-    std::stringstream stream(line);
-    while (stream >> point) {
-      hull.push_back(point);
+  const std::string Buffer = read_File(Hull_FileName);
+  const std::vector<const char*> Bounds = split_Lines(Buffer.data(), Buffer.data() + Buffer.size(), 
+                                                      NumParseThreads(Buffer.size()));
+
+  // Whitespace separated numbers, remainder of a line is skipped after an invalid entry
+  std::vector<std::vector<double>> Chunks(Bounds.size() - 1);
+  run_Parallel(Chunks.size(), [&](const size_t k) {
+    const char* Curr = Bounds[k];
+    while(Curr < Bounds[k+1]) {
+      while(Curr < Bounds[k+1] && std::isspace(static_cast<unsigned char>(*Curr)))
+        Curr++;
+      if(Curr == Bounds[k+1])
+        break;
+
+      double point;
+      const char* Pos = parse_Number(Curr, Bounds[k+1], point);
+      if(Pos != NULL) {
+        Chunks[k].push_back(point);
+        Curr = Pos;
+      }
+      else {
+        Curr = static_cast<const char*>(std::memchr(Curr, '\n', Bounds[k+1] - Curr));
+        if(Curr == NULL)
+          break;
+      }
     }
-  }
-  Hull_File.close();
+  });
+
+  for(const std::vector<double>& Chunk : Chunks)
+    hull.insert(hull.end(), Chunk.begin(), Chunk.end());
 }
 
 template <typename T>
@@ -0,0 +1,223 @@
+// This code is published under the Eclipse Public License.
+// If you have not obtained a copy of the EPL, you can find the license (version 2.0) at
+// https://www.eclipse.org/legal/epl-2.0/
+//
+// Authors:  Daniel Doehring                  RWTH Aachen University 2022-11-20
+
+#ifndef __JOBRUNNER_HPP__
+#define __JOBRUNNER_HPP__
+
+#include <string>
+#include <vector>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <chrono>
+#include <atomic>
+#include <fstream>
+#include <sstream>
+#include <iostream>
+#include <filesystem>
+#include <utility>
+#include <algorithm>
+
+#include <fcntl.h>    // open
+#include <unistd.h>   // fork, execv, chdir, dup2
+#include <sys/wait.h> // waitpid
+
+/*
+Batch of independent solves, each one run as separate process (fork + exec of e.g. Roots_Real.exe)
+in its own working directory such that the fixed output file names do not clash.
+Manifest: One job per line, '#' starts a comment
+
+  Executable Arguments... [option=value ...]
+
+e.g.
+
+  Roots_Real     32 2 16 0.644076419407201705 EigenvalueList.txt Hull max_iter=500
+  Roots_Pipeline 32 2 16 0.644076419407201705 EigenvalueList.txt Hull
+
+Arguments naming existing files (or hull prefixes 'Hull' with 'Hull_real.txt') relative to the manifest
+are made absolute. The options are appended to copies of 'Roots_Real.opt' and 'Roots_RealImag.opt'
+of the launching directory, overriding entries of the same name.
+*/
+
+namespace fs = std::filesystem;
+
+struct Job {
+  std::string Exe;
+  std::vector<std::string> Args;
+  std::vector<std::pair<std::string, std::string>> Options;
+
+  fs::path Dir;
+
+  // Filled by 'run_Job'
+  int    ExitCode = -1; // Negative: Killed by signal -ExitCode
+  double WallTime = 0.;
+};
+
+inline std::vector<Job> read_Manifest(const std::string& ManifestFile) {
+  std::vector<Job> Jobs;
+
+  std::ifstream Manifest(ManifestFile);
+  if(!Manifest) {
+    std::cout << "Could not open manifest " << ManifestFile << std::endl;
+    return Jobs;
+  }
+  const fs::path ManifestDir = fs::absolute(ManifestFile).parent_path();
+
+  std::string Line;
+  while(std::getline(Manifest, Line)) {
+    const size_t Comment = Line.find('#');
+    if(Comment != std::string::npos)
+      Line.erase(Comment);
+
+    std::istringstream Tokens(Line);
+    Job NewJob;
+    if(!(Tokens >> NewJob.Exe))
+      continue; // Empty line
+
+    std::string Token;
+    while(Tokens >> Token) {
+      const size_t Eq = Token.find('=');
+      if(Eq != std::string::npos) {
+        NewJob.Options.emplace_back(Token.substr(0, Eq), Token.substr(Eq + 1));
+        continue;
+      }
+
+      const fs::path Relative = ManifestDir / Token;
+      if(fs::path(Token).is_relative() &&
+         (fs::exists(Relative) || fs::exists(Relative.string() + "_real.txt")))
+        Token = Relative.lexically_normal().string();
+
+      NewJob.Args.push_back(Token);
+    }
+    Jobs.push_back(NewJob);
+  }
+
+  return Jobs;
+}
+
+// Copy of the parameter file 'OptFile' with the options of the job, which take precedence
+inline void write_JobOptFile(const fs::path& OptFile, const Job& CurrJob) {
+  std::ofstream JobOptFile(CurrJob.Dir / OptFile.filename());
+
+  std::ifstream BaseOptFile(OptFile);
+  std::string Line;
+  while(std::getline(BaseOptFile, Line)) {
+    std::istringstream Tokens(Line);
+    std::string Name;
+    Tokens >> Name;
+
+    bool Overridden = false;
+    for(const auto& Option : CurrJob.Options)
+      Overridden = Overridden || (Option.first == Name);
+
+    if(!Overridden)
+      JobOptFile << Line << std::endl;
+  }
+
+  if(!CurrJob.Options.empty())
+    JobOptFile << std::endl << "# Job options" << std::endl;
+  for(const auto& Option : CurrJob.Options)
+    JobOptFile << Option.first << " " << Option.second << std::endl;
+}
+
+// Runs the job in its directory, output of the executable goes to 'stdout.txt'
+inline void run_Job(Job& CurrJob, const fs::path& BinDir) {
+  const fs::path ExePath = BinDir / (CurrJob.Exe + ".exe");
+
+  std::vector<std::string> Argv = {ExePath.string()};
+  Argv.insert(Argv.end(), CurrJob.Args.begin(), CurrJob.Args.end());
+  std::vector<char*> ArgvC;
+  for(std::string& Arg : Argv)
+    ArgvC.push_back(&Arg[0]);
+  ArgvC.push_back(NULL);
+
+  const auto Start = std::chrono::steady_clock::now();
+
+  const pid_t Pid = fork();
+  if(Pid == 0) {
+    // Child: Only async-signal-safe calls until exec
+    if(chdir(CurrJob.Dir.c_str()) != 0)
+      _exit(127);
+    const int Out = open("stdout.txt", O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if(Out >= 0) {
+      dup2(Out, STDOUT_FILENO);
+      dup2(Out, STDERR_FILENO);
+      close(Out);
+    }
+    execv(ArgvC[0], ArgvC.data());
+    _exit(127); // exec failed
+  }
+
+  int Status = 0;
+  if(Pid < 0)
+    CurrJob.ExitCode = 127;
+  else {
+    waitpid(Pid, &Status, 0);
+    if(WIFEXITED(Status))
+      CurrJob.ExitCode = WEXITSTATUS(Status);
+    else if(WIFSIGNALED(Status))
+      CurrJob.ExitCode = -WTERMSIG(Status);
+  }
+
+  CurrJob.WallTime = std::chrono::duration<double>(std::chrono::steady_clock::now() - Start).count();
+}
+
+/*
+Work-stealing pool: Jobs are dealt round-robin to one queue per worker. Every worker takes jobs from the back
+of its own queue and, once empty, steals from the front of the other queues. Since the jobs are
+processes of very different runtime (S, spectrum), this balances without a central scheduler.
+*/
+inline void run_Jobs(std::vector<Job>& Jobs, const fs::path& BinDir, size_t NumWorkers) {
+  NumWorkers = std::max(std::min(NumWorkers, Jobs.size()), (size_t) 1);
+
+  std::vector<std::deque<size_t>> Queues(NumWorkers);
+  std::vector<std::mutex> Locks(NumWorkers);
+  for(size_t i = 0; i < Jobs.size(); i++)
+    Queues[i % NumWorkers].push_front(i);
+
+  std::atomic<size_t> NumDone(0);
+  std::mutex PrintLock;
+
+  auto Worker = [&](const size_t Id) {
+    while(true) {
+      bool Found = false;
+      size_t JobIndex = 0;
+      for(size_t k = 0; k < NumWorkers && !Found; k++) {
+        const size_t Victim = (Id + k) % NumWorkers;
+        std::lock_guard<std::mutex> Guard(Locks[Victim]);
+        if(Queues[Victim].empty())
+          continue;
+
+        if(Victim == Id) {
+          JobIndex = Queues[Victim].back();
+          Queues[Victim].pop_back();
+        }
+        else {
+          JobIndex = Queues[Victim].front();
+          Queues[Victim].pop_front();
+        }
+        Found = true;
+      }
+      // Jobs are only removed, never added: All queues empty => done
+      if(!Found)
+        return;
+
+      run_Job(Jobs[JobIndex], BinDir);
+
+      std::lock_guard<std::mutex> Guard(PrintLock);
+      std::cout << "[" << ++NumDone << "/" << Jobs.size() << "] " << Jobs[JobIndex].Dir.filename().string()
+                << ": exit " << Jobs[JobIndex].ExitCode << " after " << Jobs[JobIndex].WallTime << " s" << std::endl;
+    }
+  };
+
+  std::vector<std::thread> Workers;
+  for(size_t i = 0; i < NumWorkers; i++)
+    Workers.emplace_back(Worker, i);
+  for(std::thread& W : Workers)
+    W.join();
+}
+
+#endif // __JOBRUNNER_HPP__
@@ -0,0 +1,95 @@
+// This code is published under the Eclipse Public License.
+// If you have not obtained a copy of the EPL, you can find the license (version 2.0) at
+// https://www.eclipse.org/legal/epl-2.0/
+//
+// Authors:  Daniel Doehring                  RWTH Aachen University 2022-11-20
+
+/*
+Maintenance of the result cache (see 'result_cache_dir'):
+Roots_Cache.exe list  CacheDir           Lists all entries with size, days since last use and description
+Roots_Cache.exe prune CacheDir Days      Removes entries not used for more than 'Days' days (0: all entries)
+*/
+
+#include <iostream>
+#include <fstream>
+#include <iomanip>
+#include <string>
+#include <chrono>
+#include <cassert>
+#include <algorithm>
+#include <filesystem>
+
+namespace fs = std::filesystem;
+
+// Days since the entry was stored or restored the last time
+double DaysSinceUse(const fs::path& Entry) {
+  const auto Age = fs::file_time_type::clock::now() - fs::last_write_time(Entry / "Meta.txt");
+  return std::chrono::duration<double>(Age).count() / 86400.;
+}
+
+uintmax_t EntrySize(const fs::path& Entry) {
+  uintmax_t Size = 0;
+  for(const fs::directory_entry& File : fs::directory_iterator(Entry))
+    if(File.is_regular_file())
+      Size += File.file_size();
+  return Size;
+}
+
+int main(int argc, char** argv) {
+  assert(argc >= 3);
+
+  const std::string Command = argv[1];
+  const fs::path CacheDir   = argv[2];
+  assert(Command == "list" || (Command == "prune" && argc == 4));
+
+  if(!fs::exists(CacheDir)) {
+    std::cout << "Cache directory " << CacheDir.string() << " does not exist." << std::endl;
+    return 1;
+  }
+
+  const double MaxDays = (Command == "prune") ? std::stod(argv[3]) : 0.;
+
+  size_t NumEntries = 0, NumRemoved = 0;
+  uintmax_t TotalSize = 0, RemovedSize = 0;
+  std::cout << std::fixed << std::setprecision(1);
+  for(const fs::directory_entry& Entry : fs::directory_iterator(CacheDir)) {
+    if(!Entry.is_directory())
+      continue;
+
+    // Entries in preparation or leftovers of interrupted jobs
+    if(!fs::exists(Entry.path() / "Meta.txt")) {
+      const double Days = std::chrono::duration<double>(fs::file_time_type::clock::now() - 
+                                                        fs::last_write_time(Entry.path())).count() / 86400.;
+      if(Command == "prune" && Days >= std::max(MaxDays, 1.))
+        fs::remove_all(Entry.path());
+      continue;
+    }
+
+    const uintmax_t Size = EntrySize(Entry.path());
+    const double Days    = DaysSinceUse(Entry.path());
+    NumEntries++;
+    TotalSize += Size;
+
+    if(Command == "list") {
+      std::string Description;
+      std::ifstream MetaFile(Entry.path() / "Meta.txt");
+      std::getline(MetaFile, Description);
+
+      std::cout << Entry.path().filename().string() << "  " << Size / 1024. << " KiB  " 
+                << Days << " d  " << Description << std::endl;
+    }
+    else if(Days >= MaxDays) {
+      fs::remove_all(Entry.path());
+      NumRemoved++;
+      RemovedSize += Size;
+    }
+  }
+
+  if(Command == "list")
+    std::cout << std::endl << NumEntries << " entries, " << TotalSize / 1024. << " KiB" << std::endl;
+  else
+    std::cout << "Removed " << NumRemoved << " of " << NumEntries << " entries (" 
+              << RemovedSize / 1024. << " KiB)" << std::endl;
+
+  return 0;
+}
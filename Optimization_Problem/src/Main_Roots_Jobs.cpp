@@ -0,0 +1,95 @@
+// This code is published under the Eclipse Public License.
+// If you have not obtained a copy of the EPL, you can find the license (version 2.0) at
+// https://www.eclipse.org/legal/epl-2.0/
+//
+// Authors:  Daniel Doehring                  RWTH Aachen University 2022-11-20
+
+/*
+Runs a batch of solves (see 'JobRunner.hpp' for the manifest) in parallel:
+Roots_Jobs.exe Manifest [NumWorkers] [JobsDir]
+
+NumWorkers defaults to the number of hardware threads, JobsDir to './Jobs'.
+Job i runs in 'JobsDir/<i>_<Executable>_S<S>_p<p>', the executables are taken from the directory of Roots_Jobs.exe.
+A summary table is printed and written to 'JobsDir/Summary.txt'.
+*/
+
+#include "JobRunner.hpp"
+
+#include <iostream>
+#include <fstream>
+#include <iomanip>
+#include <string>
+#include <thread>
+#include <cassert>
+
+void write_Summary(std::ostream& Out, const std::vector<Job>& Jobs, const double TotalTime) {
+  size_t NumFailed = 0;
+  double SumTime   = 0.;
+
+  Out << std::left << std::setw(40) << "Job" << std::right << std::setw(8) << "Exit"
+      << std::setw(14) << "Time [s]" << "  Status" << std::endl;
+  for(const Job& CurrJob : Jobs) {
+    std::string Status = "ok";
+    if(CurrJob.ExitCode == 127)
+      Status = "not started";
+    else if(CurrJob.ExitCode < 0)
+      Status = "killed by signal " + std::to_string(-CurrJob.ExitCode);
+    // Ipopt return status (1: Solved to acceptable level, 255: Maximum iterations exceeded, ...)
+    else if(CurrJob.ExitCode == 1)
+      Status = "ok (acceptable level)";
+    else if(CurrJob.ExitCode != 0)
+      Status = "Ipopt status " + std::to_string((signed char) CurrJob.ExitCode);
+
+    if(CurrJob.ExitCode != 0 && CurrJob.ExitCode != 1)
+      NumFailed++;
+    SumTime += CurrJob.WallTime;
+
+    Out << std::left << std::setw(40) << CurrJob.Dir.filename().string() << std::right << std::setw(8)
+        << CurrJob.ExitCode << std::setw(14) << std::fixed << std::setprecision(2) << CurrJob.WallTime
+        << "  " << Status << std::endl;
+  }
+  Out << std::endl << Jobs.size() - NumFailed << " of " << Jobs.size() << " jobs succeeded, "
+      << SumTime << " s total runtime in " << TotalTime << " s wall-clock time" << std::endl;
+}
+
+int main(int argc, char** argv) {
+  assert(argc >= 2);
+
+  const size_t NumWorkers = (argc >= 3) ? std::stoul(argv[2]) : std::max(std::thread::hardware_concurrency(), 1u);
+  const fs::path JobsDir  = (argc >= 4) ? fs::path(argv[3]) : fs::path("./Jobs");
+  const fs::path BinDir   = fs::absolute(argv[0]).parent_path();
+
+  std::vector<Job> Jobs = read_Manifest(argv[1]);
+  if(Jobs.empty()) {
+    std::cout << "No jobs in " << argv[1] << std::endl;
+    return 1;
+  }
+
+  for(size_t i = 0; i < Jobs.size(); i++) {
+    Job& CurrJob = Jobs[i];
+
+    std::string Name = std::to_string(i) + "_" + CurrJob.Exe;
+    if(CurrJob.Args.size() >= 2)
+      Name += "_S" + CurrJob.Args[0] + "_p" + CurrJob.Args[1];
+    CurrJob.Dir = fs::absolute(JobsDir / Name);
+
+    fs::create_directories(CurrJob.Dir);
+    for(const std::string OptFile : {"Roots_Real.opt", "Roots_RealImag.opt"})
+      write_JobOptFile(OptFile, CurrJob);
+  }
+
+  std::cout << "Run " << Jobs.size() << " jobs on " << NumWorkers << " workers" << std::endl;
+  const auto Start = std::chrono::steady_clock::now();
+
+  run_Jobs(Jobs, BinDir, NumWorkers);
+
+  const double TotalTime = std::chrono::duration<double>(std::chrono::steady_clock::now() - Start).count();
+
+  std::cout << std::endl;
+  write_Summary(std::cout, Jobs, TotalTime);
+
+  std::ofstream SummaryFile(JobsDir / "Summary.txt");
+  write_Summary(SummaryFile, Jobs, TotalTime);
+
+  return 0;
+}
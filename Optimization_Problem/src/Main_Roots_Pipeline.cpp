@@ -0,0 +1,118 @@
+// Copyright (C) 2005, 2006 International Business Machines and others.
+// All Rights Reserved.
+// This code is published under the Eclipse Public License.
+// If you have not obtained a copy of the EPL, you can find the license (version 2.0) at
+// https://www.eclipse.org/legal/epl-2.0/
+//
+// Authors:  Carl Laird, Andreas Waechter     IBM                    2005-08-16
+//           Daniel Doehring                  RWTH Aachen University 2022-11-20
+
+/*
+Combined real-only and real-imaginary optimization in one process:
+The spectrum (and hull) is read once, the solution of Roots_Real and its constraint multipliers are handed
+to Roots_RealImag in memory (warmstart). Only the final files (including the P-ERK coefficients) are written.
+Usage: Roots_Pipeline.exe S p S_ref dt_ref Spectrum (PathToHullPoints)
+*/
+
+#include "IpIpoptApplication.hpp"
+#include "Roots_Real.hpp"
+#include "Roots_RealImag.hpp"
+
+#include <iostream>
+
+#include "IO_Funcs.hpp"
+#include "OSPREI_Options.hpp"
+#include "AutoTimestep.hpp"
+
+using namespace Ipopt;
+
+int main(int argc, char** argv) {
+   assert(argc >= 6);
+
+   const int NumStages    = std::stoi(argv[1]);
+   const int ConsOrder    = std::stoi(argv[2]);
+   const int NumStagesRef = std::stoi(argv[3]);
+   // Number, 'auto' or 'auto:Jacobian.mtx' (see 'AutoTimestep.hpp')
+   const Number dtRef     = parse_dtRef(std::string(argv[4]), std::string(argv[5]), NumStages, ConsOrder, NumStagesRef);
+
+   // Currently only order 1 to 4 are implemented
+   assert(ConsOrder == 1 || ConsOrder == 2 || ConsOrder == 3 || ConsOrder == 4);
+
+   // Separate applications since Roots_Real and Roots_RealImag use different parameter files
+   SmartPtr<IpoptApplication> appReal     = IpoptApplicationFactory();
+   SmartPtr<IpoptApplication> appRealImag = IpoptApplicationFactory();
+   register_OSPREI_options(appReal->RegOptions());
+   register_OSPREI_options(appRealImag->RegOptions());
+
+   appReal->Options()->SetStringValue("output_file", "Roots_Real.out");
+   appReal->Options()->SetStringValue("option_file_name", "Roots_Real.opt");
+
+   appRealImag->Options()->SetStringValue("output_file", "Roots_RealImag.out");
+   appRealImag->Options()->SetStringValue("option_file_name", "Roots_RealImag.opt");
+   // Do no relaxation of bounds
+   appRealImag->Options()->SetNumericValue("bound_relax_factor", std::numeric_limits<Number>::epsilon());
+
+   if(ConsOrder == 1) {
+      // There are no equality constraints => constant Eq.-Constr. Jacobian
+      appReal->Options()->SetStringValue("jac_c_constant", "yes");
+      appRealImag->Options()->SetStringValue("jac_c_constant", "yes");
+   }
+
+   // Initialize the IpoptApplications and process the options
+   ApplicationReturnStatus status;
+   status = appReal->Initialize();
+   if( status == Solve_Succeeded )
+      status = appRealImag->Initialize();
+
+   if( status != Solve_Succeeded ) {
+      std::cout << std::endl << std::endl << "*** Error during initialization!" << std::endl;
+      return (int) status;
+   }
+
+   // Start real-imaginary phase from the real-only multipliers
+   appRealImag->Options()->SetStringValue("warm_start_init_point", "yes");
+
+   Number DedupTol;
+   appReal->Options()->GetNumericValue("eigval_dedup_tol", DedupTol, "");
+
+   // Read spectrum once
+   int NumEigVals = -1;
+   std::vector<Number> RealEigVals, ImagEigVals;
+   read_EigVals(std::string(argv[5]), NumEigVals, RealEigVals, ImagEigVals, DedupTol);
+
+   // Interpolation curve: Either supplied hull or the (sorted) eigenvalues themselves
+   std::vector<Number> CurveReal, CurveImag;
+   if(argc == 7) {
+      read_Hull(std::string(argv[6]) + "_real.txt", CurveReal);
+      read_Hull(std::string(argv[6]) + "_imag.txt", CurveImag);
+   }
+   else {
+      CurveReal = RealEigVals;
+      CurveImag = ImagEigVals;
+   }
+
+   /// Real-only phase ///
+   SmartPtr<Roots_Real> nlpReal = new Roots_Real(NumStages, ConsOrder, NumStagesRef, dtRef, 
+                                                 RealEigVals, ImagEigVals, CurveReal, CurveImag);
+   nlpReal->set_write_output(false);
+   status = appReal->OptimizeTNLP(GetRawPtr(nlpReal));
+
+   const std::vector<Number> xReal = nlpReal->get_solution();
+   std::vector<Number> zLReal, zUReal, lambdaReal;
+   nlpReal->get_duals(zLReal, zUReal, lambdaReal);
+
+   /// Real-imaginary phase ///
+   SmartPtr<Roots_RealImag> nlpRealImag = new Roots_RealImag(NumStages, ConsOrder, NumStagesRef, dtRef, 
+                                                             RealEigVals, ImagEigVals, CurveReal, CurveImag, 
+                                                             xReal);
+
+   // Same constraints => Same constraint multipliers. The bounds differ (box around the real-only roots, dt >= 0),
+   // hence the bound multipliers start from zero (lifted by 'warm_start_mult_bound_push')
+   nlpRealImag->set_warm_start(std::vector<Number>(), std::vector<Number>(), std::vector<Number>(), lambdaReal);
+
+   status = appRealImag->OptimizeTNLP(GetRawPtr(nlpRealImag));
+
+   std::cout << std::endl << std::endl << "*** The problem terminated!" << std::endl;
+
+   return (int) status;
+}
@@ -10,32 +10,41 @@
 
 #include "IpIpoptApplication.hpp"
 #include "Roots_RealImag.hpp"
+#include "OSPREI_Options.hpp"
+#include "Spectra.hpp"
+#include "ResultCache.hpp"
+#include "ResultBundle.hpp"
+#include "SpectrumStream.hpp"
+#include "AutoTimestep.hpp"
 
 #include <iostream>
+#include <algorithm>
 
 using namespace Ipopt;
 
 int main(int argc, char** argv) {
-   assert(argc >= 6);
+   // Restart an interrupted run from its checkpoint: Append '--resume' to the usual arguments
+   const bool Resume = (argc > 1 && std::string(argv[argc-1]) == "--resume");
+   if(Resume)
+      argc--;
+
+   // Joint optimization for several spectra: NumStages ConsOrder --spectra SpectraListFile
+   const bool MultiSpectra = (argc == 5 && std::string(argv[3]) == "--spectra");
+   assert(argc >= 6 || MultiSpectra);
 
    const int NumStages    = std::stoi(argv[1]);
    const int ConsOrder    = std::stoi(argv[2]);
-   const int NumStagesRef = std::stoi(argv[3]);
-   const Number dtRef     = std::stod(argv[4]);
+   int NumStagesRef       = MultiSpectra ? 0 : std::stoi(argv[3]);
+   // 'auto' or 'auto:Jacobian.mtx' instead of dtRef: Estimated from spectrum or sparse operator (see 'AutoTimestep.hpp')
+   const bool AutoRef     = !MultiSpectra && is_AutoRef(std::string(argv[4]));
+   Number dtRef           = (MultiSpectra || AutoRef) ? 0. : std::stod(argv[4]);
 
    // Currently only order 1 to 4 are implemented
    assert(ConsOrder == 1 || ConsOrder == 2 || ConsOrder == 3 || ConsOrder == 4);
 
-   // Create a new instance of your nlp (use Ipopt::SmartPtr)
-   SmartPtr<TNLP> mynlp;
-   if(argc == 7)
-      // Case for which hull is used
-      mynlp = new Roots_RealImag(NumStages, ConsOrder, NumStagesRef, dtRef, std::string(argv[5]), std::string(argv[6]));
-   else
-      mynlp = new Roots_RealImag(NumStages, ConsOrder, NumStagesRef, dtRef, std::string(argv[5]));
-
    // Create a new instance of IpoptApplication (use Ipopt::SmartPtr)
    SmartPtr<IpoptApplication> app = IpoptApplicationFactory();
+   register_OSPREI_options(app->RegOptions());
 
    app->Options()->SetStringValue("output_file", "Roots_RealImag.out");
 
@@ -58,8 +67,194 @@ int main(int argc, char** argv) {
       return (int) status;
    }
 
-   // Ask Ipopt to solve the problem
-   status = app->OptimizeTNLP(mynlp);
+   // Optional merging of (near-)duplicate eigenvalues
+   Number DedupTol;
+   app->Options()->GetNumericValue("eigval_dedup_tol", DedupTol, "");
+
+   // Content-addressed result cache: Return without building the NLP if this problem has been solved before
+   std::string CacheDir, Key;
+   app->Options()->GetStringValue("result_cache_dir", CacheDir, "");
+   // Streamed eigenvalues cannot be hashed before they are read
+   const bool Streamed = !MultiSpectra && is_SpectrumStream(std::string(argv[5]));
+   if(Streamed && !CacheDir.empty()) {
+      std::cout << "Result cache is not used for streamed spectra" << std::endl;
+      CacheDir.clear();
+   }
+   // Streamed spectrum: Estimate once the eigenvalues are read
+   if(AutoRef && !(Streamed && std::string(argv[4]) == "auto"))
+      dtRef = parse_dtRef(std::string(argv[4]), std::string(argv[5]), NumStages, ConsOrder, NumStagesRef);
+
+   if(!CacheDir.empty()) {
+      // Parameter file (Ipopt and OSPREI options) and file used for initialization are inputs as well
+      std::vector<std::string> InputFiles = {"Roots_RealImag.opt", "./Real_Optimized_" + std::to_string(NumStages) + ".txt"};
+      const std::string InitBundle = ResultBundlePrefix("Real", NumStages);
+      InputFiles.push_back(InitBundle + ".json");
+      InputFiles.push_back(InitBundle + ".bin");
+      if(MultiSpectra) {
+         InputFiles.push_back(std::string(argv[4]));
+         for(const std::string& EigValFileName : read_SpectraFileNames(std::string(argv[4])))
+            InputFiles.push_back(EigValFileName);
+      }
+      else {
+         InputFiles.push_back(std::string(argv[5]));
+         if(argc == 7) {
+            InputFiles.push_back(std::string(argv[6]) + "_real.txt");
+            InputFiles.push_back(std::string(argv[6]) + "_imag.txt");
+         }
+      }
+      // Persisted primal-dual solution used as starting point
+      std::string PersistWarmStart;
+      app->Options()->GetStringValue("warm_start_persistence", PersistWarmStart, "");
+      if(PersistWarmStart == "yes")
+         for(const std::string& WarmStartFile : WarmStartFiles("RealImag", NumStages))
+            InputFiles.push_back(WarmStartFile);
+      Key = CacheKey("RealImag", NumStages, ConsOrder, NumStagesRef, dtRef, InputFiles);
+
+      if(restore_from_cache(CacheDir, Key, ResultFiles("RealImag", NumStages))) {
+         std::cout << std::endl << std::endl << "*** The problem terminated!" << std::endl;
+         return (int) Solve_Succeeded;
+      }
+   }
+
+   // Create a new instance of your nlp (use Ipopt::SmartPtr)
+   // In-memory constraint sets: Start from the solution of Roots_Real
+   std::vector<Number> xReal;
+   if(MultiSpectra || Streamed) {
+      const bool Found_x0 = read_x0_Result(NumStages, xReal, NumStages / 2 + 1);
+      assert(Found_x0);
+   }
+
+   SmartPtr<Roots_RealImag> mynlp;
+   if(MultiSpectra) {
+      // Combined constraint set w.r.t. the first spectrum, upper convex hull as interpolation curve
+      std::vector<Number> RealEigVals, ImagEigVals, HullReal, HullImag;
+      read_Spectra(std::string(argv[4]), RealEigVals, ImagEigVals, dtRef, NumStagesRef, DedupTol);
+      UpperConvexHull(RealEigVals, ImagEigVals, HullReal, HullImag);
+
+      mynlp = new Roots_RealImag(NumStages, ConsOrder, NumStagesRef, dtRef, RealEigVals, ImagEigVals, HullReal, HullImag,
+                                 xReal);
+   }
+   else if(Streamed) {
+      // Only the upper convex hull of the eigenvalues is kept: Constraint set and (if no hull is given) interpolation curve
+      std::vector<Number> RealEigVals, ImagEigVals, HullReal, HullImag;
+      read_EigVals_Stream(std::string(argv[5]), RealEigVals, ImagEigVals);
+      // Leftmost and topmost eigenvalue are vertices of the upper convex hull
+      if(AutoRef && dtRef == 0.) {
+         double MaxAbsReal, MaxAbsImag;
+         SpectrumExtents(RealEigVals, ImagEigVals, MaxAbsReal, MaxAbsImag);
+         dtRef = auto_dtRef(NumStages, ConsOrder, NumStagesRef, MaxAbsReal, MaxAbsImag);
+      }
+      if(argc == 7) {
+         read_Hull(std::string(argv[6]) + "_real.txt", HullReal);
+         read_Hull(std::string(argv[6]) + "_imag.txt", HullImag);
+      }
+      else {
+         HullReal = RealEigVals;
+         HullImag = ImagEigVals;
+      }
+
+      mynlp = new Roots_RealImag(NumStages, ConsOrder, NumStagesRef, dtRef, RealEigVals, ImagEigVals, HullReal, HullImag,
+                                 xReal);
+   }
+   else if(argc == 7)
+      // Case for which hull is used
+      mynlp = new Roots_RealImag(NumStages, ConsOrder, NumStagesRef, dtRef, std::string(argv[5]), std::string(argv[6]), DedupTol);
+   else
+      mynlp = new Roots_RealImag(NumStages, ConsOrder, NumStagesRef, dtRef, std::string(argv[5]), DedupTol);
+
+   // Time budget and stagnation criterion
+   Number TimeBudget, StagnationTol, StagnationFeasTol;
+   Index StagnationIter;
+   app->Options()->GetNumericValue("time_budget", TimeBudget, "");
+   app->Options()->GetIntegerValue("stagnation_iter", StagnationIter, "");
+   app->Options()->GetNumericValue("stagnation_tol", StagnationTol, "");
+   app->Options()->GetNumericValue("stagnation_feas_tol", StagnationFeasTol, "");
+   mynlp->set_budget(TimeBudget, StagnationIter, StagnationTol, StagnationFeasTol);
+
+   // Text files and/or result bundle
+   std::string ResultFormat;
+   app->Options()->GetStringValue("result_format", ResultFormat, "");
+   mynlp->set_result_format(ResultFormat);
+
+   // Periodic checkpoints and restart of an interrupted run
+   Index CheckpointInterval;
+   app->Options()->GetIntegerValue("checkpoint_interval", CheckpointInterval, "");
+   mynlp->set_checkpointing(CheckpointInterval);
+
+   // Warmstart from the stored primal-dual solution of a previous run (if any)
+   std::string PersistWarmStart;
+   app->Options()->GetStringValue("warm_start_persistence", PersistWarmStart, "");
+   if(PersistWarmStart == "yes" && mynlp->enable_warm_start_persistence())
+      app->Options()->SetStringValue("warm_start_init_point", "yes");
+
+   Index  MaxIter;
+   Number MuInit;
+   app->Options()->GetIntegerValue("max_iter", MaxIter, "");
+   app->Options()->GetNumericValue("mu_init", MuInit, "");
+   if(Resume) {
+      Number ResumeMu;
+      const Index ResumeIter = mynlp->resume_from_checkpoint(ResumeMu);
+      if(ResumeIter >= 0) {
+         app->Options()->SetStringValue("warm_start_init_point", "yes");
+
+         // Only the remaining iterations, continue with the barrier parameter of the checkpoint
+         app->Options()->SetIntegerValue("max_iter", std::max(MaxIter - ResumeIter, (Index) 0));
+         app->Options()->SetNumericValue("mu_init", ResumeMu);
+      }
+   }
+
+   // Only the first solve is resumed, later ones (aggregation continuation, polish) run with the user settings
+   auto Solve = [&]() {
+      const ApplicationReturnStatus SolveStatus = app->OptimizeTNLP(GetRawPtr(mynlp));
+      app->Options()->SetIntegerValue("max_iter", MaxIter);
+      app->Options()->SetNumericValue("mu_init", MuInit);
+      return SolveStatus;
+   };
+
+   std::string AggregationName;
+   app->Options()->GetStringValue("stab_constr_aggregation", AggregationName, "");
+
+   if(AggregationName == "none")
+      // Ask Ipopt to solve the problem
+      status = Solve();
+   else {
+      const StabConstrAggregation Aggregation = (AggregationName == "ks") ? KS_Aggregation : PNorm_Aggregation;
+
+      Index NumBlocks, ContinuationSteps;
+      Number AggrParam, AggrParamFactor;
+      app->Options()->GetIntegerValue("aggregation_blocks", NumBlocks, "");
+      app->Options()->GetIntegerValue("aggregation_continuation_steps", ContinuationSteps, "");
+      app->Options()->GetNumericValue("aggregation_parameter", AggrParam, "");
+      app->Options()->GetNumericValue("aggregation_parameter_factor", AggrParamFactor, "");
+
+      // Continuation: Tighten the aggregation, warmstart from the previous solution (roots and corrections)
+      // Solution files and P-ERK coefficients only for the final polish
+      mynlp->set_write_output(false);
+      for(Index k = 0; k < ContinuationSteps; k++) {
+         mynlp->set_aggregation(Aggregation, NumBlocks, AggrParam);
+         status = Solve();
+         mynlp->set_warm_start(mynlp->xyOpt, {}, {}, {});
+
+         AggrParam *= AggrParamFactor;
+      }
+
+      // Final polish with the exact constraints
+      mynlp->set_aggregation(NoAggregation, 0, 0.);
+      mynlp->set_write_output(true);
+      status = Solve();
+   }
+
+   if(!CacheDir.empty() && (status == Solve_Succeeded || status == Solved_To_Acceptable_Level)) {
+      const std::vector<Number>& x      = mynlp->xyOpt;
+      const std::vector<Number>& zL     = mynlp->zLOpt;
+      const std::vector<Number>& zU     = mynlp->zUOpt;
+      const std::vector<Number>& lambda = mynlp->lambdaOpt;
+
+      std::stringstream Description;
+      Description << "RealImag S = " << NumStages << " p = " << ConsOrder << " S_ref = " << NumStagesRef 
+                  << " dt_ref = " << dtRef << " " << (MultiSpectra ? argv[4] : argv[5]);
+      store_in_cache(CacheDir, Key, ResultFiles("RealImag", NumStages), x, zL, zU, lambda, Description.str());
+   }
 
    std::cout << std::endl << std::endl << "*** The problem terminated!" << std::endl;
 
@@ -0,0 +1,180 @@
+// Copyright (C) 2005, 2006 International Business Machines and others.
+// All Rights Reserved.
+// This code is published under the Eclipse Public License.
+// If you have not obtained a copy of the EPL, you can find the license (version 2.0) at
+// https://www.eclipse.org/legal/epl-2.0/
+//
+// Authors:  Carl Laird, Andreas Waechter     IBM                    2005-08-16
+//           Daniel Doehring                  RWTH Aachen University 2022-11-20
+
+/*
+Stage-count continuation for the real-only optimization of high degree polynomials:
+Starting from S_start (initialized as usual), S is increased by 'stage_continuation_step' up to S_end
+(the last increment is shortened if S_end - S_start is not a multiple of it).
+For every step the roots of the previous solution are resampled along the arc length of the interpolation curve,
+the timestep is extrapolated linearly in S, and bound and constraint multipliers are reused (warmstart).
+Usage: Roots_Real_Continuation.exe S_start S_end p S_ref dt_ref Spectrum (PathToHullPoints)
+*/
+
+#include "IpIpoptApplication.hpp"
+#include "Roots_Real.hpp"
+
+#include <iostream>
+#include <fstream>
+#include <iomanip>
+#include <numeric>
+#include <algorithm>
+
+#include "IO_Funcs.hpp"
+#include "StageContinuation.hpp"
+#include "OSPREI_Options.hpp"
+#include "AutoTimestep.hpp"
+
+using namespace Ipopt;
+
+int main(int argc, char** argv) {
+   assert(argc >= 7);
+
+   const int NumStagesStart = std::stoi(argv[1]);
+   const int NumStagesEnd   = std::stoi(argv[2]);
+   const int ConsOrder      = std::stoi(argv[3]);
+   const int NumStagesRef   = std::stoi(argv[4]);
+   // Number, 'auto' or 'auto:Jacobian.mtx' (see 'AutoTimestep.hpp')
+   const Number dtRef       = parse_dtRef(std::string(argv[5]), std::string(argv[6]), NumStagesEnd, ConsOrder, NumStagesRef);
+
+   // Currently only order 1 to 4 are implemented
+   assert(ConsOrder == 1 || ConsOrder == 2 || ConsOrder == 3 || ConsOrder == 4);
+   // CAVEAT: Hard-coded to even stability polynoms only!
+   if(NumStagesStart % 2 != 0 || NumStagesEnd % 2 != 0 || NumStagesEnd < NumStagesStart) {
+      std::cout << "S_start and S_end must be even with S_start <= S_end" << std::endl;
+      return (int) Invalid_Option;
+   }
+
+   // Create a new instance of IpoptApplication (use Ipopt::SmartPtr)
+   SmartPtr<IpoptApplication> app = IpoptApplicationFactory();
+   register_OSPREI_options(app->RegOptions());
+
+   app->Options()->SetStringValue("output_file", "Roots_Real_Continuation.out");
+
+   // The following overwrites the default name (ipopt.opt) of the options file
+   app->Options()->SetStringValue("option_file_name", "Roots_Real.opt");
+
+   if(ConsOrder == 1)
+      // There are no equality constraints => constant Eq.-Constr. Jacobian (not sure if option does something)
+      app->Options()->SetStringValue("jac_c_constant", "yes");
+
+   // Initialize the IpoptApplication and process the options
+   ApplicationReturnStatus status;
+   status = app->Initialize();
+
+   if( status != Solve_Succeeded ) {
+      std::cout << std::endl << std::endl << "*** Error during initialization!" << std::endl;
+      return (int) status;
+   }
+
+   Number DedupTol;
+   Index Step;
+   app->Options()->GetNumericValue("eigval_dedup_tol", DedupTol, "");
+   app->Options()->GetIntegerValue("stage_continuation_step", Step, "");
+   if(Step % 2 != 0) {
+      std::cout << "stage_continuation_step must be even" << std::endl;
+      return (int) Invalid_Option;
+   }
+
+   // Read spectrum once
+   int NumEigVals = -1;
+   std::vector<Number> RealEigVals, ImagEigVals;
+   read_EigVals(std::string(argv[6]), NumEigVals, RealEigVals, ImagEigVals, DedupTol);
+
+   // Interpolation curve: Either supplied hull or the (sorted) eigenvalues themselves
+   std::vector<Number> CurveReal, CurveImag;
+   if(argc == 8) {
+      read_Hull(std::string(argv[7]) + "_real.txt", CurveReal);
+      read_Hull(std::string(argv[7]) + "_imag.txt", CurveImag);
+   }
+   else {
+      CurveReal = RealEigVals;
+      CurveImag = ImagEigVals;
+   }
+
+   std::ofstream ContinuationFile("./Continuation_" + std::to_string(ConsOrder) + ".txt");
+   ContinuationFile << "# S dt dt/dtExp Iterations\n";
+   ContinuationFile << std::setprecision(std::numeric_limits<Number>::max_digits10);
+
+   // Solution and multipliers of the previous step
+   std::vector<Number> xPrev, zLPrev, zUPrev, lambdaPrev;
+   int NumStagesPrev = 0;
+   Index TotalIter = 0;
+
+   // The last step is shortened if S_end - S_start is not a multiple of the step
+   for(int NumStages = NumStagesStart; NumStagesPrev < NumStagesEnd; NumStages = std::min(NumStages + Step, NumStagesEnd)) {
+      std::cout << std::endl << "### Continuation step S = " << NumStages << " ###" << std::endl << std::endl;
+
+      SmartPtr<Roots_Real> mynlp = new Roots_Real(NumStages, ConsOrder, NumStagesRef, dtRef, 
+                                                  RealEigVals, ImagEigVals, CurveReal, CurveImag);
+      // Solution files only for the final polynomial
+      mynlp->set_write_output(NumStages == NumStagesEnd);
+
+      if(!xPrev.empty()) {
+         const int NumRootsPrev = NumStagesPrev / 2;
+         const int NumRoots     = NumStages / 2;
+         const Number dtExp     = mynlp->get_dtExp();
+
+         // Roots (scaled with dtExp of S_prev) rescaled to the current dtExp, sorted along the curve
+         const Number Factor = static_cast<Number>(NumStages) / NumStagesPrev;
+         std::vector<size_t> Perm(NumRootsPrev);
+         std::iota(Perm.begin(), Perm.end(), 0);
+         std::sort(Perm.begin(), Perm.end(), [&](const size_t a, const size_t b) { return xPrev[a] < xPrev[b]; });
+
+         std::vector<Number> RootsPrev(NumRootsPrev), zLRoots(NumRootsPrev), zURoots(NumRootsPrev);
+         for(int i = 0; i < NumRootsPrev; i++) {
+            RootsPrev[i] = xPrev[Perm[i]] * Factor;
+            zLRoots[i]   = zLPrev.empty() ? 0. : zLPrev[Perm[i]];
+            zURoots[i]   = zUPrev.empty() ? 0. : zUPrev[Perm[i]];
+         }
+
+         std::vector<Number> CurveRealScaled(CurveReal), CurveImagScaled(CurveImag);
+         for(size_t i = 0; i < CurveReal.size(); i++) {
+            CurveRealScaled[i] *= dtExp;
+            CurveImagScaled[i] *= dtExp;
+         }
+
+         std::vector<Number> x = ResampleRoots(RootsPrev, NumRoots, CurveRealScaled, CurveImagScaled);
+         // Maximum timestep grows (approximately) linear in S
+         x.push_back(xPrev[NumRootsPrev] * Factor);
+
+         std::vector<Number> zL = ResampleByIndex(zLRoots, NumRoots);
+         std::vector<Number> zU = ResampleByIndex(zURoots, NumRoots);
+         if(!zLPrev.empty()) {
+            zL.push_back(zLPrev[NumRootsPrev]);
+            zU.push_back(zUPrev[NumRootsPrev]);
+         }
+         else {
+            zL.clear();
+            zU.clear();
+         }
+
+         // Constraints (eigenvalues, order conditions) do not depend on S, multipliers are reused directly
+         mynlp->set_warm_start(x, zL, zU, lambdaPrev);
+         app->Options()->SetStringValue("warm_start_init_point", "yes");
+      }
+
+      status = app->OptimizeTNLP(GetRawPtr(mynlp));
+      const Index Iter = IsValid(app->Statistics()) ? app->Statistics()->IterationCount() : 0;
+      TotalIter += Iter;
+
+      xPrev = mynlp->get_solution();
+      mynlp->get_duals(zLPrev, zUPrev, lambdaPrev);
+      NumStagesPrev = NumStages;
+
+      const Number dt = xPrev.back();
+      ContinuationFile << NumStages << " " << dt << " " << dt / mynlp->get_dtExp() << " " << Iter << "\n";
+      std::cout << std::endl << "S = " << NumStages << ": dt = " << dt << " (" << Iter << " iterations)" << std::endl;
+   }
+   ContinuationFile.close();
+
+   std::cout << std::endl << "Total number of iterations: " << TotalIter << std::endl;
+   std::cout << std::endl << std::endl << "*** The problem terminated!" << std::endl;
+
+   return (int) status;
+}
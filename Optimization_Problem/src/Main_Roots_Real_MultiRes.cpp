@@ -0,0 +1,123 @@
+// Copyright (C) 2005, 2006 International Business Machines and others.
+// All Rights Reserved.
+// This code is published under the Eclipse Public License.
+// If you have not obtained a copy of the EPL, you can find the license (version 2.0) at
+// https://www.eclipse.org/legal/epl-2.0/
+//
+// Authors:  Carl Laird, Andreas Waechter     IBM                    2005-08-16
+//           Daniel Doehring                  RWTH Aachen University 2022-11-20
+
+/*
+Coarse-to-fine multi-resolution mode for the real-only optimization:
+The problem is first solved for a coarse subset of the eigenvalues, then every finer level is 
+warmstarted from roots, timestep and multipliers of the previous level.
+The interpolation curve (hull, if supplied, or the polygon through all sorted eigenvalues) is the same on all levels.
+*/
+
+#include "IpIpoptApplication.hpp"
+#include "Roots_Real.hpp"
+
+#include <iostream>
+#include <algorithm>
+
+#include "IO_Funcs.hpp"
+#include "MultiRes.hpp"
+#include "OSPREI_Options.hpp"
+#include "AutoTimestep.hpp"
+
+using namespace Ipopt;
+
+int main(int argc, char** argv) {
+   assert(argc >= 6);
+
+   const int NumStages    = std::stoi(argv[1]);
+   const int ConsOrder    = std::stoi(argv[2]);
+   const int NumStagesRef = std::stoi(argv[3]);
+   // Number, 'auto' or 'auto:Jacobian.mtx' (see 'AutoTimestep.hpp')
+   const Number dtRef     = parse_dtRef(std::string(argv[4]), std::string(argv[5]), NumStages, ConsOrder, NumStagesRef);
+
+   // Currently only order 1 to 4 are implemented
+   assert(ConsOrder == 1 || ConsOrder == 2 || ConsOrder == 3 || ConsOrder == 4);
+
+   // Create a new instance of IpoptApplication (use Ipopt::SmartPtr)
+   SmartPtr<IpoptApplication> app = IpoptApplicationFactory();
+   register_OSPREI_options(app->RegOptions());
+
+   app->Options()->SetStringValue("output_file", "Roots_Real_MultiRes.out");
+
+   // The following overwrites the default name (ipopt.opt) of the options file
+   app->Options()->SetStringValue("option_file_name", "Roots_Real.opt");
+
+   if(ConsOrder == 1)
+      // There are no equality constraints => constant Eq.-Constr. Jacobian (not sure if option does something)
+      app->Options()->SetStringValue("jac_c_constant", "yes");
+
+   // Initialize the IpoptApplication and process the options
+   ApplicationReturnStatus status;
+   status = app->Initialize();
+
+   if( status != Solve_Succeeded ) {
+      std::cout << std::endl << std::endl << "*** Error during initialization!" << std::endl;
+      return (int) status;
+   }
+
+   Number DedupTol;
+   Index NumLevels, Coarsening;
+   app->Options()->GetNumericValue("eigval_dedup_tol", DedupTol, "");
+   app->Options()->GetIntegerValue("multires_levels", NumLevels, "");
+   app->Options()->GetIntegerValue("multires_coarsening", Coarsening, "");
+
+   int NumEigVals = -1;
+   std::vector<Number> RealEigVals, ImagEigVals;
+   read_EigVals(std::string(argv[5]), NumEigVals, RealEigVals, ImagEigVals, DedupTol);
+
+   // Interpolation curve: Either supplied hull or the (sorted) eigenvalues themselves
+   std::vector<Number> CurveReal, CurveImag;
+   if(argc == 7) {
+      read_Hull(std::string(argv[6]) + "_real.txt", CurveReal);
+      read_Hull(std::string(argv[6]) + "_imag.txt", CurveImag);
+   }
+   else {
+      CurveReal = RealEigVals;
+      CurveImag = ImagEigVals;
+   }
+
+   std::vector<size_t> IndicesCoarse;
+   std::vector<Number> xWarm, zLWarm, zUWarm, lambdaWarm;
+
+   for(Index Level = NumLevels - 1; Level >= 0; Level--) {
+      size_t Stride = 1;
+      for(Index l = 0; l < Level; l++)
+         Stride *= Coarsening;
+
+      const std::vector<size_t> Indices = LevelIndices(NumEigVals, Stride);
+      std::vector<Number> LevelReal(Indices.size()), LevelImag(Indices.size());
+      for(size_t j = 0; j < Indices.size(); j++) {
+         LevelReal[j] = RealEigVals[Indices[j]];
+         LevelImag[j] = ImagEigVals[Indices[j]];
+      }
+
+      std::cout << std::endl << "### Level " << Level << " with " << Indices.size() 
+                << " of " << NumEigVals << " eigenvalues ###" << std::endl << std::endl;
+
+      SmartPtr<Roots_Real> mynlp = new Roots_Real(NumStages, ConsOrder, NumStagesRef, dtRef, 
+                                                  LevelReal, LevelImag, CurveReal, CurveImag);
+      // Solution files only for the full spectrum
+      mynlp->set_write_output(Level == 0);
+      if(!xWarm.empty()) {
+         mynlp->set_warm_start(xWarm, zLWarm, zUWarm, 
+                               ProlongateMultipliers(lambdaWarm, IndicesCoarse, Indices));
+         app->Options()->SetStringValue("warm_start_init_point", "yes");
+      }
+
+      status = app->OptimizeTNLP(GetRawPtr(mynlp));
+
+      xWarm = mynlp->get_solution();
+      mynlp->get_duals(zLWarm, zUWarm, lambdaWarm);
+      IndicesCoarse = Indices;
+   }
+
+   std::cout << std::endl << std::endl << "*** The problem terminated!" << std::endl;
+
+   return (int) status;
+}
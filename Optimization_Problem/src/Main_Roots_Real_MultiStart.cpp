@@ -0,0 +1,233 @@
+// Copyright (C) 2005, 2006 International Business Machines and others.
+// All Rights Reserved.
+// This code is published under the Eclipse Public License.
+// If you have not obtained a copy of the EPL, you can find the license (version 2.0) at
+// https://www.eclipse.org/legal/epl-2.0/
+//
+// Authors:  Carl Laird, Andreas Waechter     IBM                    2005-08-16
+//           Daniel Doehring                  RWTH Aachen University 2022-11-20
+
+/*
+Multi-start mode for the (nonconvex) real-only optimization:
+Several starting root distributions are solved concurrently, the best feasible solution wins.
+The starts share the best feasible timestep found so far (incumbent), starts lagging behind are aborted.
+Since the dco tapes are global and the linear solvers are not necessarily thread-safe, every start is 
+solved in a separate (forked) process, the incumbent and the results reside in shared memory.
+*/
+
+#include "IpIpoptApplication.hpp"
+#include "Roots_Real.hpp"
+
+#include <iostream>
+#include <filesystem>
+#include <thread>
+#include <limits>
+#include <new>
+#include <atomic>
+#include <map>
+
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "IO_Funcs.hpp"
+#include "ResultBundle.hpp"
+#include "MultiStart.hpp"
+#include "OSPREI_Options.hpp"
+#include "AutoTimestep.hpp"
+
+using namespace Ipopt;
+
+int main(int argc, char** argv) {
+   assert(argc >= 6);
+
+   const int NumStages    = std::stoi(argv[1]);
+   const int ConsOrder    = std::stoi(argv[2]);
+   const int NumStagesRef = std::stoi(argv[3]);
+   // Number, 'auto' or 'auto:Jacobian.mtx' (see 'AutoTimestep.hpp')
+   const Number dtRef     = parse_dtRef(std::string(argv[4]), std::string(argv[5]), NumStages, ConsOrder, NumStagesRef);
+
+   // Currently only order 1 to 4 are implemented
+   assert(ConsOrder == 1 || ConsOrder == 2 || ConsOrder == 3 || ConsOrder == 4);
+
+   // Create a new instance of IpoptApplication (use Ipopt::SmartPtr)
+   SmartPtr<IpoptApplication> app = IpoptApplicationFactory();
+   register_OSPREI_options(app->RegOptions());
+
+   // The following overwrites the default name (ipopt.opt) of the options file
+   app->Options()->SetStringValue("option_file_name", "Roots_Real.opt");
+
+   if(ConsOrder == 1)
+      // There are no equality constraints => constant Eq.-Constr. Jacobian (not sure if option does something)
+      app->Options()->SetStringValue("jac_c_constant", "yes");
+
+   // Initialize the IpoptApplication and process the options
+   ApplicationReturnStatus status;
+   status = app->Initialize();
+
+   if( status != Solve_Succeeded ) {
+      std::cout << std::endl << std::endl << "*** Error during initialization!" << std::endl;
+      return (int) status;
+   }
+
+   Number DedupTol, Perturbation, AbortMargin, FeasTol;
+   Index NumStarts, NumProcesses, Seed, AbortIter;
+   app->Options()->GetNumericValue("eigval_dedup_tol", DedupTol, "");
+   app->Options()->GetIntegerValue("multistart_starts", NumStarts, "");
+   app->Options()->GetIntegerValue("multistart_processes", NumProcesses, "");
+   app->Options()->GetNumericValue("multistart_perturbation", Perturbation, "");
+   app->Options()->GetIntegerValue("multistart_seed", Seed, "");
+   app->Options()->GetNumericValue("multistart_abort_margin", AbortMargin, "");
+   app->Options()->GetIntegerValue("multistart_abort_iter", AbortIter, "");
+   app->Options()->GetNumericValue("constr_viol_tol", FeasTol, "");
+   if(NumProcesses == 0)
+      NumProcesses = std::max(1u, std::thread::hardware_concurrency());
+
+   int NumEigVals = -1;
+   std::vector<Number> RealEigVals, ImagEigVals;
+   read_EigVals(std::string(argv[5]), NumEigVals, RealEigVals, ImagEigVals, DedupTol);
+
+   // Interpolation curve: Either supplied hull or the (sorted) eigenvalues themselves
+   std::vector<Number> CurveReal, CurveImag;
+   if(argc == 7) {
+      read_Hull(std::string(argv[6]) + "_real.txt", CurveReal);
+      read_Hull(std::string(argv[6]) + "_imag.txt", CurveImag);
+   }
+   else {
+      CurveReal = RealEigVals;
+      CurveImag = ImagEigVals;
+   }
+
+   // Also used for writing the files of the best solution
+   SmartPtr<Roots_Real> mynlp = new Roots_Real(NumStages, ConsOrder, NumStagesRef, dtRef, 
+                                               RealEigVals, ImagEigVals, CurveReal, CurveImag);
+   const int NumRoots    = NumStages / 2;
+   const int NumUnknowns = NumRoots + 1;
+
+   /// Starting root distributions ///
+   const std::vector<Number> x0Base = mynlp->get_initial_point();
+   // Within the variable bounds of the NLP (eigenvalues, not interpolation curve), otherwise projected by Ipopt
+   const Number RealMin = mynlp->get_RealMin();
+   const Number RealUB  = mynlp->get_RealUB();
+
+   std::vector<std::vector<Number>> Starts{x0Base};
+   if(NumStarts > 1)
+      Starts.push_back(ChebyshevRootDistr(NumRoots, RealMin, RealUB, x0Base[NumRoots]));
+
+   std::vector<Number> xPrev;
+   if(NumStarts > 2 && read_x0_Result(NumStages, xPrev, NumUnknowns))
+      Starts.push_back(xPrev);
+
+   std::mt19937 Generator(Seed);
+   while(Starts.size() < NumStarts)
+      Starts.push_back(PerturbedRootDistr(x0Base, NumRoots, RealMin, RealUB, Perturbation, Generator));
+
+   /// Shared memory: Incumbent timestep, then for every start (infeasibility, roots, timestep) ///
+   // Atomics are shared across processes only if they do not fall back to (process-local) locks
+   static_assert(std::atomic<Number>::is_always_lock_free, "Incumbent in shared memory requires lock-free atomics");
+   const size_t SlotSize   = NumUnknowns + 1;
+   const size_t SharedSize = sizeof(std::atomic<Number>) + NumStarts * SlotSize * sizeof(Number);
+   void* Shared = mmap(NULL, SharedSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+   assert(Shared != MAP_FAILED);
+
+   std::atomic<Number>* Incumbent = new(Shared) std::atomic<Number>(0.);
+   Number* Results = reinterpret_cast<Number*>(static_cast<char*>(Shared) + sizeof(std::atomic<Number>));
+   for(Index k = 0; k < NumStarts; k++)
+      Results[k * SlotSize] = std::numeric_limits<Number>::infinity(); // Marks unfinished starts
+
+   // Children which crashed (e.g. killed by a signal) or failed leave incomplete results behind
+   std::map<pid_t, Index> Children;
+   std::vector<bool> Failed(NumStarts, false);
+   auto WaitForChild = [&]() {
+      int ExitStatus;
+      const pid_t pid = waitpid(-1, &ExitStatus, 0);
+      if(pid <= 0)
+         return false;
+
+      const Index k = Children[pid];
+      if(!WIFEXITED(ExitStatus) || WEXITSTATUS(ExitStatus) != 0) {
+         Failed[k] = true;
+         std::cout << "CARE: Start " << k << " failed (" 
+                   << (WIFSIGNALED(ExitStatus) ? "signal " + std::to_string(WTERMSIG(ExitStatus)) : 
+                                                 "exit code " + std::to_string(WEXITSTATUS(ExitStatus)))
+                   << ")" << std::endl;
+      }
+      return true;
+   };
+
+   Index NumRunning = 0;
+   for(Index k = 0; k < NumStarts; k++) {
+      if(NumRunning == NumProcesses) {
+         WaitForChild();
+         NumRunning--;
+      }
+
+      std::cout.flush();
+      const pid_t pid = fork();
+      assert(pid >= 0);
+      if(pid == 0) { // Child: Solve start k
+         app->Options()->SetStringValue("output_file", "Roots_Real_MultiStart_" + std::to_string(k) + ".out");
+         app->Initialize();
+
+         SmartPtr<Roots_Real> nlp = new Roots_Real(NumStages, ConsOrder, NumStagesRef, dtRef, 
+                                                   RealEigVals, ImagEigVals, CurveReal, CurveImag);
+         nlp->set_initial_point(Starts[k]);
+         nlp->set_write_output(false);
+         nlp->set_incumbent(Incumbent, AbortMargin, FeasTol, AbortIter);
+
+         app->OptimizeTNLP(GetRawPtr(nlp));
+
+         const std::vector<Number> x = nlp->get_solution();
+         std::copy(x.begin(), x.end(), Results + k * SlotSize + 1);
+         Results[k * SlotSize] = nlp->get_infeasibility();
+
+         std::cout.flush();
+         _exit(0);
+      }
+      Children[pid] = k;
+      NumRunning++;
+   }
+   while(WaitForChild());
+
+   /// Best start: Largest feasible timestep, otherwise smallest infeasibility ///
+   Index Best = -1;
+   for(Index k = 0; k < NumStarts; k++) {
+      if(Failed[k])
+         continue;
+
+      const Number InfPr = Results[k * SlotSize];
+      const Number dt    = Results[k * SlotSize + NumUnknowns];
+      std::cout << "Start " << k << ": Infeasibility " << InfPr << " timestep " << dt << std::endl;
+
+      if(Best < 0) {
+         Best = k;
+         continue;
+      }
+      const Number InfPrB = Results[Best * SlotSize];
+      const Number dtB    = Results[Best * SlotSize + NumUnknowns];
+      if(InfPr <= FeasTol ? (InfPrB > FeasTol || dt > dtB) : (InfPrB > FeasTol && InfPr < InfPrB))
+         Best = k;
+   }
+   if(Best < 0) {
+      std::cout << std::endl << "*** All starts failed!" << std::endl;
+      munmap(Shared, SharedSize);
+      return (int) Internal_Error;
+   }
+   std::cout << std::endl << "Best start: " << Best << " with timestep " 
+             << Results[Best * SlotSize + NumUnknowns] << std::endl;
+
+   // Text files and/or result bundle as for a single start
+   std::string ResultFormat;
+   app->Options()->GetStringValue("result_format", ResultFormat, "");
+   mynlp->set_result_format(ResultFormat);
+
+   mynlp->set_solution(std::vector<Number>(Results + Best * SlotSize + 1, Results + (Best + 1) * SlotSize));
+   mynlp->write_results();
+
+   status = (Results[Best * SlotSize] <= FeasTol) ? Solve_Succeeded : Infeasible_Problem_Detected;
+   munmap(Shared, SharedSize);
+
+   std::cout << std::endl << std::endl << "*** The problem terminated!" << std::endl;
+
+   return (int) status;
+}
@@ -0,0 +1,167 @@
+// Copyright (C) 2005, 2006 International Business Machines and others.
+// All Rights Reserved.
+// This code is published under the Eclipse Public License.
+// If you have not obtained a copy of the EPL, you can find the license (version 2.0) at
+// https://www.eclipse.org/legal/epl-2.0/
+//
+// Authors:  Carl Laird, Andreas Waechter     IBM                    2005-08-16
+//           Daniel Doehring                  RWTH Aachen University 2022-11-20
+
+/*
+Semi-infinite programming (exchange) mode for the real-only optimization:
+The stability constraint is required on the whole envelope of the spectrum (hull, if supplied, or 
+the polygon through the sorted eigenvalues otherwise). Starting from a coarse sampling of that curve, 
+the maximizers of |R(z)| between neighboring samples are located by golden section searches, 
+added to the constraint set and the problem is re-solved (warm-started) until max |R(z)| <= 1 + tol.
+*/
+
+#include "IpIpoptApplication.hpp"
+#include "Roots_Real.hpp"
+
+#include <iostream>
+#include <fstream>
+#include <iomanip>
+#include <algorithm>
+
+#include "IO_Funcs.hpp"
+#include "SemiInfinite.hpp"
+#include "Spectra.hpp" // For 'UpperConvexHull'
+#include "OSPREI_Options.hpp"
+#include "AutoTimestep.hpp"
+
+using namespace Ipopt;
+
+int main(int argc, char** argv) {
+   assert(argc >= 6);
+
+   const int NumStages    = std::stoi(argv[1]);
+   const int ConsOrder    = std::stoi(argv[2]);
+   const int NumStagesRef = std::stoi(argv[3]);
+   // Number, 'auto' or 'auto:Jacobian.mtx' (see 'AutoTimestep.hpp')
+   const Number dtRef     = parse_dtRef(std::string(argv[4]), std::string(argv[5]), NumStages, ConsOrder, NumStagesRef);
+
+   // Currently only order 1 to 4 are implemented
+   assert(ConsOrder == 1 || ConsOrder == 2 || ConsOrder == 3 || ConsOrder == 4);
+
+   // Envelope of the spectrum: Either supplied hull or the upper convex hull of the (sorted) eigenvalues
+   std::vector<Number> CurveReal, CurveImag;
+   if(argc == 7) {
+      read_Hull(std::string(argv[6]) + "_real.txt", CurveReal);
+      read_Hull(std::string(argv[6]) + "_imag.txt", CurveImag);
+      assert(CurveReal.size() == CurveImag.size());
+   }
+   else {
+      int NumEigVals = -1;
+      std::vector<Number> RealEigVals, ImagEigVals;
+      read_EigVals(std::string(argv[5]), NumEigVals, RealEigVals, ImagEigVals);
+      UpperConvexHull(RealEigVals, ImagEigVals, CurveReal, CurveImag);
+   }
+   assert(CurveReal.size() >= 2);
+   const std::vector<Number> ArcLengths = CurveArcLengths(CurveReal, CurveImag);
+
+   // Create a new instance of IpoptApplication (use Ipopt::SmartPtr)
+   SmartPtr<IpoptApplication> app = IpoptApplicationFactory();
+   register_OSPREI_options(app->RegOptions());
+
+   app->Options()->SetStringValue("output_file", "Roots_Real_SIP.out");
+
+   // The following overwrites the default name (ipopt.opt) of the options file
+   app->Options()->SetStringValue("option_file_name", "Roots_Real.opt");
+
+   if(ConsOrder == 1)
+      // There are no equality constraints => constant Eq.-Constr. Jacobian (not sure if option does something)
+      app->Options()->SetStringValue("jac_c_constant", "yes");
+
+   // Initialize the IpoptApplication and process the options
+   ApplicationReturnStatus status;
+   status = app->Initialize();
+
+   if( status != Solve_Succeeded ) {
+      std::cout << std::endl << std::endl << "*** Error during initialization!" << std::endl;
+      return (int) status;
+   }
+
+   Index NumSamples, MaxExchangeIter, MaxAddedPoints;
+   Number Tol;
+   app->Options()->GetIntegerValue("sip_initial_samples", NumSamples, "");
+   app->Options()->GetIntegerValue("sip_max_exchange_iter", MaxExchangeIter, "");
+   app->Options()->GetIntegerValue("sip_max_added_points", MaxAddedPoints, "");
+   app->Options()->GetNumericValue("sip_tol", Tol, "");
+
+   // Arc length positions of the constraint points on the envelope
+   std::vector<Number> Samples = InitialCurveSamples(NumSamples, ArcLengths);
+   std::vector<Number> SampleReal, SampleImag;
+   std::vector<Number> xWarm;
+   Number MaxAbsPnom = 42.;
+
+   for(Index iter = 0; iter < MaxExchangeIter; iter++) {
+      std::cout << std::endl << "### Exchange iteration " << iter << " with " << Samples.size() 
+                << " constraint points ###" << std::endl << std::endl;
+
+      SampleReal.resize(Samples.size());
+      SampleImag.resize(Samples.size());
+      for(size_t j = 0; j < Samples.size(); j++)
+         CurvePoint(Samples[j], ArcLengths, CurveReal, CurveImag, SampleReal[j], SampleImag[j]);
+
+      SmartPtr<Roots_Real> mynlp = new Roots_Real(NumStages, ConsOrder, NumStagesRef, dtRef, 
+                                                  SampleReal, SampleImag, CurveReal, CurveImag);
+      if(!xWarm.empty())
+         mynlp->set_initial_point(xWarm);
+
+      status = app->OptimizeTNLP(GetRawPtr(mynlp));
+      xWarm  = mynlp->get_solution();
+
+      // Locate the maximizers of |R(z(s))| between neighboring samples
+      auto AbsPnom = [&](const Number s) {
+         Number Real, Imag;
+         CurvePoint(s, ArcLengths, CurveReal, CurveImag, Real, Imag);
+         return mynlp->eval_AbsStabPnom(Real, Imag);
+      };
+
+      std::vector<std::pair<Number, Number>> Violations; // (|R|, arc length)
+      MaxAbsPnom = 0.;
+      for(size_t j = 0; j < Samples.size() - 1; j++) {
+         Number fMax;
+         const Number sMax = GoldenSectionMax(AbsPnom, Samples[j], Samples[j+1], 
+                                              1e-6 * (Samples[j+1] - Samples[j]), fMax);
+         MaxAbsPnom = std::max(MaxAbsPnom, fMax);
+
+         // Do not add (numerically) existing points again
+         if(fMax > 1. + Tol && 
+            std::min(sMax - Samples[j], Samples[j+1] - sMax) > 1e-10 * ArcLengths.back())
+            Violations.push_back(std::make_pair(fMax, sMax));
+      }
+
+      std::cout << std::endl << "Maximum of |R(z)| along the envelope: " << MaxAbsPnom 
+                << " (" << Violations.size() << " violating intervals)" << std::endl;
+
+      if(Violations.empty())
+         break;
+
+      // Add the largest violations to the constraint set
+      std::sort(Violations.begin(), Violations.end(), 
+                [](const std::pair<Number, Number>& a, const std::pair<Number, Number>& b) {
+                   return a.first > b.first;
+                });
+      for(size_t k = 0; k < std::min(Violations.size(), (size_t) MaxAddedPoints); k++)
+         Samples.push_back(Violations[k].second);
+      std::sort(Samples.begin(), Samples.end());
+   }
+
+   if(MaxAbsPnom > 1. + Tol)
+      std::cout << std::endl << "CARE: Exchange method did not reach the requested tolerance!" << std::endl;
+
+   // Store the final (reduced) constraint set in the usual eigenvalue format
+   std::ofstream SIP_File("./SIP_Points_" + std::to_string(NumStages) + ".txt");
+   SIP_File << std::setprecision(std::numeric_limits<Number>::max_digits10);
+   for(size_t j = 0; j < SampleReal.size(); j++) {
+      SIP_File << SampleReal[j] << "+" << SampleImag[j] << "i";
+      if(j != SampleReal.size() - 1)
+         SIP_File << "\n";
+   }
+   SIP_File.close();
+
+   std::cout << std::endl << std::endl << "*** The problem terminated!" << std::endl;
+
+   return (int) status;
+}
@@ -0,0 +1,151 @@
+// Copyright (C) 2005, 2006 International Business Machines and others.
+// All Rights Reserved.
+// This code is published under the Eclipse Public License.
+// If you have not obtained a copy of the EPL, you can find the license (version 2.0) at
+// https://www.eclipse.org/legal/epl-2.0/
+//
+// Authors:  Carl Laird, Andreas Waechter     IBM                    2005-08-16
+//           Daniel Doehring                  RWTH Aachen University 2022-11-20
+
+/*
+Stage-count sweep: Optimizes a family of polynomials (e.g. S = 4,8,16,32) in one process.
+The spectrum (and hull) is read once, for every S first Roots_Real and then Roots_RealImag is solved.
+The solution for S/2 (if part of the sweep) initializes the optimization for S via its pseudo-extrema
+and the Roots_Real solution is handed to Roots_RealImag in memory.
+Usage: Roots_Sweep.exe S_1,S_2,... p S_ref dt_ref Spectrum (PathToHullPoints)
+*/
+
+#include "IpIpoptApplication.hpp"
+#include "Roots_Real.hpp"
+#include "Roots_RealImag.hpp"
+
+#include <iostream>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <chrono>
+#include <map>
+
+#include "IO_Funcs.hpp"
+#include "OSPREI_Options.hpp"
+#include "AutoTimestep.hpp"
+
+using namespace Ipopt;
+
+// Separate applications since Roots_Real and Roots_RealImag use different parameter files
+SmartPtr<IpoptApplication> Create_App(const std::string Name, const int ConsOrder) {
+   SmartPtr<IpoptApplication> app = IpoptApplicationFactory();
+   register_OSPREI_options(app->RegOptions());
+
+   app->Options()->SetStringValue("output_file", Name + ".out");
+
+   // The following overwrites the default name (ipopt.opt) of the options file
+   app->Options()->SetStringValue("option_file_name", Name + ".opt");
+
+   if(ConsOrder == 1)
+      // There are no equality constraints => constant Eq.-Constr. Jacobian
+      app->Options()->SetStringValue("jac_c_constant", "yes");
+
+   return app;
+}
+
+int main(int argc, char** argv) {
+   assert(argc >= 6);
+
+   std::vector<int> StagesList;
+   std::stringstream StagesStream(argv[1]);
+   std::string Stages;
+   while(std::getline(StagesStream, Stages, ','))
+      StagesList.push_back(std::stoi(Stages));
+
+   const int ConsOrder    = std::stoi(argv[2]);
+   const int NumStagesRef = std::stoi(argv[3]);
+   // Number, 'auto' or 'auto:Jacobian.mtx' (see 'AutoTimestep.hpp'), estimated for the largest S
+   const int NumStagesMax = *std::max_element(StagesList.begin(), StagesList.end());
+   const Number dtRef     = parse_dtRef(std::string(argv[4]), std::string(argv[5]), NumStagesMax, ConsOrder, NumStagesRef);
+
+   // Currently only order 1 to 4 are implemented
+   assert(ConsOrder == 1 || ConsOrder == 2 || ConsOrder == 3 || ConsOrder == 4);
+
+   SmartPtr<IpoptApplication> appReal     = Create_App("Roots_Real", ConsOrder);
+   SmartPtr<IpoptApplication> appRealImag = Create_App("Roots_RealImag", ConsOrder);
+
+   // Do no relaxation of bounds
+   appRealImag->Options()->SetNumericValue("bound_relax_factor", std::numeric_limits<Number>::epsilon());
+
+   // Initialize the IpoptApplications and process the options
+   ApplicationReturnStatus status;
+   status = appReal->Initialize();
+   if( status == Solve_Succeeded )
+      status = appRealImag->Initialize();
+
+   if( status != Solve_Succeeded ) {
+      std::cout << std::endl << std::endl << "*** Error during initialization!" << std::endl;
+      return (int) status;
+   }
+
+   Number DedupTol;
+   appReal->Options()->GetNumericValue("eigval_dedup_tol", DedupTol, "");
+
+   // Read spectrum once
+   int NumEigVals = -1;
+   std::vector<Number> RealEigVals, ImagEigVals;
+   read_EigVals(std::string(argv[5]), NumEigVals, RealEigVals, ImagEigVals, DedupTol);
+
+   // Interpolation curve: Either supplied hull or the (sorted) eigenvalues themselves
+   std::vector<Number> CurveReal, CurveImag;
+   if(argc == 7) {
+      read_Hull(std::string(argv[6]) + "_real.txt", CurveReal);
+      read_Hull(std::string(argv[6]) + "_imag.txt", CurveImag);
+   }
+   else {
+      CurveReal = RealEigVals;
+      CurveImag = ImagEigVals;
+   }
+
+   std::map<int, std::vector<Number>> Solutions; // Roots_RealImag solutions (scaled) for every S
+   std::ofstream SweepFile("./Sweep_" + std::to_string(ConsOrder) + ".txt");
+   SweepFile << "# S dt dt/dtExp t_Real[s] t_RealImag[s]\n";
+   SweepFile << std::setprecision(std::numeric_limits<Number>::max_digits10);
+
+   for(const int NumStages : StagesList) {
+      std::cout << std::endl << "### Optimize S = " << NumStages << " ###" << std::endl << std::endl;
+
+      // Pseudo-extrema initialization from S/2, if available
+      std::vector<Number> Real_PE_HalfStages;
+      if(NumStages % 2 == 0 && Solutions.count(NumStages/2))
+         Real_PE_HalfStages = Solutions[NumStages/2];
+
+      const auto t0 = std::chrono::steady_clock::now();
+
+      SmartPtr<Roots_Real> nlpReal = new Roots_Real(NumStages, ConsOrder, NumStagesRef, dtRef, 
+                                                    RealEigVals, ImagEigVals, CurveReal, CurveImag, 
+                                                    Real_PE_HalfStages);
+      status = appReal->OptimizeTNLP(GetRawPtr(nlpReal));
+
+      const auto t1 = std::chrono::steady_clock::now();
+
+      SmartPtr<Roots_RealImag> nlpRealImag = new Roots_RealImag(NumStages, ConsOrder, NumStagesRef, dtRef, 
+                                                                RealEigVals, ImagEigVals, CurveReal, CurveImag, 
+                                                                nlpReal->get_solution());
+      status = appRealImag->OptimizeTNLP(GetRawPtr(nlpRealImag));
+
+      const auto t2 = std::chrono::steady_clock::now();
+
+      Solutions[NumStages] = nlpRealImag->xyOpt;
+
+      const Number dt = nlpRealImag->xyOpt.back();
+      const double tReal     = std::chrono::duration<double>(t1 - t0).count();
+      const double tRealImag = std::chrono::duration<double>(t2 - t1).count();
+      SweepFile << NumStages << " " << dt << " " << dt / nlpRealImag->dtExp << " " 
+                << tReal << " " << tRealImag << "\n";
+
+      std::cout << std::endl << "S = " << NumStages << ": dt = " << dt << " (" << tReal << "s + " 
+                << tRealImag << "s)" << std::endl;
+   }
+   SweepFile.close();
+
+   std::cout << std::endl << std::endl << "*** The problem terminated!" << std::endl;
+
+   return (int) status;
+}
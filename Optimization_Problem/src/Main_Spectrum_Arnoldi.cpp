@@ -0,0 +1,102 @@
+// This code is published under the Eclipse Public License.
+// If you have not obtained a copy of the EPL, you can find the license (version 2.0) at
+// https://www.eclipse.org/legal/epl-2.0/
+//
+// Authors:  Daniel Doehring                  RWTH Aachen University 2022-11-20
+
+/*
+Boundary eigenvalues of a sparse Jacobian instead of a full dense eigendecomposition:
+Spectrum_Arnoldi.exe Jacobian.mtx EigenvalueList.txt|Spectrum.bin [NumEigVals] [NumShifts]
+
+'Jacobian.mtx' is the Jacobian of the semi-discretization in (real, coordinate) Matrix Market format.
+Per target (largest magnitude, most negative real part, largest imaginary part) and per shift along the hull
+'NumEigVals' (default 20) eigenvalues are computed, with 'NumShifts' (default 10) shifts.
+The result is written as eigenvalue list (text) or, for the extension '.bin', as binary spectrum with hull,
+i.e., it can be passed directly to Roots_Real.exe / Roots_RealImag.exe.
+*/
+
+#include "Arnoldi.hpp"
+#include "SpectrumBinary.hpp"
+
+#include <iostream>
+#include <iomanip>
+#include <limits>
+#include <string>
+#include <chrono>
+#include <cassert>
+
+int main(int argc, char** argv) {
+  assert(argc >= 3);
+
+  const std::string MatrixFileName   = argv[1];
+  const std::string SpectrumFileName = argv[2];
+  const int NumEigVals = (argc >= 4) ? std::stoi(argv[3]) : 20;
+  const int NumShifts  = (argc >= 5) ? std::stoi(argv[4]) : 10;
+  assert(NumEigVals >= 1 && NumShifts >= 0);
+
+  const auto Start = std::chrono::steady_clock::now();
+  const Eigen::SparseMatrix<double> A = read_MatrixMarket(MatrixFileName);
+
+  const int KrylovDim = std::max(2 * NumEigVals + 1, 20);
+  std::vector<std::complex<double>> EigVals;
+  // Small systems: Dense eigendecomposition is cheaper than (several) restarted Arnoldi runs
+  if(A.rows() <= 2 * KrylovDim) {
+    std::cout << "Small system: Dense eigendecomposition" << std::endl;
+    Eigen::EigenSolver<Eigen::MatrixXd> Solver(Eigen::MatrixXd(A), false);
+    for(Eigen::Index i = 0; i < A.rows(); i++)
+      EigVals.push_back(Solver.eigenvalues()(i));
+  }
+  else {
+    bool ExtentsFound;
+    EigVals = ExtremalEigVals(A, NumEigVals, KrylovDim, ExtentsFound);
+    // Spectrum would be cut short, i.e., optimized polynomials may be unstable
+    if(!ExtentsFound) {
+      std::cout << "Extremal eigenvalues did not converge, try a larger NumEigVals (Krylov dimension)" << std::endl;
+      return 1;
+    }
+    const std::vector<std::complex<double>> ShiftEigVals = HullShiftEigVals(A, EigVals, NumShifts, NumEigVals, KrylovDim);
+    EigVals.insert(EigVals.end(), ShiftEigVals.begin(), ShiftEigVals.end());
+  }
+
+  // Real coefficients of the stability polynomial: Mirror to the upper half plane
+  std::vector<double> RealEigVals, ImagEigVals;
+  std::sort(EigVals.begin(), EigVals.end(), [](const std::complex<double>& a, const std::complex<double>& b) {
+    return a.real() < b.real() || (a.real() == b.real() && std::abs(a.imag()) < std::abs(b.imag()));
+  });
+  double MaxAbs = 0.;
+  for(const std::complex<double>& Lambda : EigVals) {
+    RealEigVals.push_back(Lambda.real());
+    ImagEigVals.push_back(std::abs(Lambda.imag()));
+    MaxAbs = std::max(MaxAbs, std::abs(Lambda));
+  }
+  // Same eigenvalues found by several targets/shifts
+  std::vector<int> Multiplicity;
+  dedup_EigVals(RealEigVals, ImagEigVals, std::max(MaxAbs, 1.) * 1e-8, &Multiplicity);
+
+  const double Seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - Start).count();
+  std::cout << "Computed " << RealEigVals.size() << " distinct eigenvalues in " << Seconds << " s" << std::endl;
+  // Complex conjugate pairs are merged as well (multiplicity 2)
+  report_Multiplicity(Multiplicity);
+
+  if(SpectrumFileName.size() >= 4 && SpectrumFileName.compare(SpectrumFileName.size() - 4, 4, ".bin") == 0) {
+    std::vector<double> HullReal, HullImag;
+    UpperConvexHull(RealEigVals, ImagEigVals, HullReal, HullImag);
+    if(!write_BinarySpectrum(SpectrumFileName, RealEigVals, ImagEigVals, HullReal, HullImag, true, 1.)) {
+      std::cout << "Could not write " << SpectrumFileName << std::endl;
+      return 1;
+    }
+  }
+  else {
+    std::ofstream File(SpectrumFileName);
+    File << std::setprecision(std::numeric_limits<double>::max_digits10);
+    for(size_t i = 0; i < RealEigVals.size(); i++)
+      File << RealEigVals[i] << "+" << ImagEigVals[i] << "i" << std::endl;
+    if(!File) {
+      std::cout << "Could not write " << SpectrumFileName << std::endl;
+      return 1;
+    }
+  }
+
+  std::cout << "Wrote eigenvalues to " << SpectrumFileName << std::endl;
+  return 0;
+}
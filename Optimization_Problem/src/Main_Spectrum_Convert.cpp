@@ -0,0 +1,50 @@
+// This code is published under the Eclipse Public License.
+// If you have not obtained a copy of the EPL, you can find the license (version 2.0) at
+// https://www.eclipse.org/legal/epl-2.0/
+//
+// Authors:  Daniel Doehring                  RWTH Aachen University 2022-11-20
+
+/*
+Conversion of a text spectrum (and hull) to the binary format of 'SpectrumBinary.hpp':
+Spectrum_Convert.exe EigenvalueList.txt Spectrum.bin [Hull] [Scaling]
+
+'Hull' is the prefix of 'Hull_real.txt' and 'Hull_imag.txt' ("-": no hull), the eigenvalues are stored sorted.
+The values are stored exactly as read. With 'Scaling' (default 1) the spectrum and hull are read as 'Scaling' times
+the stored values, e.g. to rescale a spectrum without converting it again.
+*/
+
+#include "IO_Funcs.hpp"
+
+#include <iostream>
+#include <string>
+#include <cassert>
+
+int main(int argc, char** argv) {
+  assert(argc >= 3);
+
+  const std::string EigValFileName   = argv[1];
+  const std::string SpectrumFileName = argv[2];
+  const std::string HullPointPath    = (argc >= 4) ? argv[3] : "-";
+  const double Scaling               = (argc >= 5) ? std::stod(argv[4]) : 1.;
+  assert(Scaling != 0.);
+
+  int NumEigVals;
+  std::vector<double> RealEigVals, ImagEigVals;
+  read_EigVals(EigValFileName, NumEigVals, RealEigVals, ImagEigVals);
+
+  std::vector<double> HullReal, HullImag;
+  if(HullPointPath != "-") {
+    read_Hull(HullPointPath + "_real.txt", HullReal);
+    read_Hull(HullPointPath + "_imag.txt", HullImag);
+    assert(HullReal.size() == HullImag.size());
+  }
+
+  if(!write_BinarySpectrum(SpectrumFileName, RealEigVals, ImagEigVals, HullReal, HullImag, true, Scaling)) {
+    std::cout << "Could not write " << SpectrumFileName << std::endl;
+    return 1;
+  }
+
+  std::cout << "Wrote " << NumEigVals << " eigenvalues and " << HullReal.size() << " hull points to " 
+            << SpectrumFileName << std::endl;
+  return 0;
+}
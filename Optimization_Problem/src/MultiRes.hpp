@@ -0,0 +1,53 @@
+// This code is published under the Eclipse Public License.
+// If you have not obtained a copy of the EPL, you can find the license (version 2.0) at
+// https://www.eclipse.org/legal/epl-2.0/
+//
+// Authors:  Daniel Doehring                  RWTH Aachen University 2022-11-20
+
+#ifndef __MULTIRES_HPP__
+#define __MULTIRES_HPP__
+
+#include <vector>
+#include <cstddef>
+
+/*
+Coarse-to-fine solution over a pyramid of spectrum resolutions.
+Level l uses every (Coarsening^l)-th eigenvalue (sorted w.r.t. real part), level 0 all of them.
+Since the strides are multiples of each other, the levels are nested.
+*/
+
+// Indices of the eigenvalues on a level. First and last (extremal real part) eigenvalue are always contained.
+inline std::vector<size_t> LevelIndices(const size_t NumEigVals, const size_t Stride) {
+  std::vector<size_t> Indices;
+  for(size_t i = 0; i < NumEigVals; i += Stride)
+    Indices.push_back(i);
+  if(Indices.back() != NumEigVals - 1)
+    Indices.push_back(NumEigVals - 1);
+
+  return Indices;
+}
+
+// Multipliers of the coarse level for the constraints of the fine level.
+// Stability constraints not present on the coarse level start inactive (zero), order constraints are copied.
+template<typename T>
+std::vector<T> ProlongateMultipliers(const std::vector<T>& lambdaCoarse,
+                                     const std::vector<size_t>& IndicesCoarse,
+                                     const std::vector<size_t>& IndicesFine) {
+  const size_t NumOrderConstr = lambdaCoarse.size() - IndicesCoarse.size();
+  std::vector<T> lambdaFine(IndicesFine.size() + NumOrderConstr, 0.);
+
+  size_t j = 0;
+  for(size_t i = 0; i < IndicesFine.size() && j < IndicesCoarse.size(); i++) {
+    if(IndicesFine[i] == IndicesCoarse[j]) {
+      lambdaFine[i] = lambdaCoarse[j];
+      j++;
+    }
+  }
+
+  for(size_t k = 0; k < NumOrderConstr; k++)
+    lambdaFine[IndicesFine.size() + k] = lambdaCoarse[IndicesCoarse.size() + k];
+
+  return lambdaFine;
+}
+
+#endif
@@ -0,0 +1,49 @@
+// This code is published under the Eclipse Public License.
+// If you have not obtained a copy of the EPL, you can find the license (version 2.0) at
+// https://www.eclipse.org/legal/epl-2.0/
+//
+// Authors:  Daniel Doehring                  RWTH Aachen University 2022-11-20
+
+#ifndef __MULTISTART_HPP__
+#define __MULTISTART_HPP__
+
+#include <vector>
+#include <cmath>
+#include <random>
+#include <algorithm>
+
+/*
+Alternative starting root distributions (real parts, scaled) for the nonconvex real-only problem.
+Layout as for 'InitialRootDistr': NumRoots real parts followed by the timestep.
+*/
+
+// Chebyshev-like distribution of the real parts in [RealMin, RealMax): Roots cluster towards the ends
+template<typename T>
+std::vector<T> ChebyshevRootDistr(const int NumRoots, const T RealMin, const T RealMax, const T dt) {
+  const T pi = std::acos(T(-1.)); // 'M_PI' is not standard C++
+
+  std::vector<T> x0(NumRoots + 1);
+  for(int i = 0; i < NumRoots; i++)
+    x0[i] = RealMax - (RealMax - RealMin) * 0.5 * (1. + std::cos(pi * i / NumRoots));
+  x0[NumRoots] = dt;
+
+  return x0;
+}
+
+// Random perturbation of the real parts by 'Amplitude' times the distance to the left neighbor.
+// The first (left-most) root is kept, as for even polynomials.
+template<typename T>
+std::vector<T> PerturbedRootDistr(const std::vector<T>& x0Base, const int NumRoots, 
+                                  const T RealMin, const T RealUB, const T Amplitude, std::mt19937& Generator) {
+  std::uniform_real_distribution<T> Uniform(-1., 1.);
+
+  std::vector<T> x0 = x0Base;
+  for(int i = 1; i < NumRoots; i++) {
+    x0[i] += Amplitude * std::abs(x0Base[i] - x0Base[i-1]) * Uniform(Generator);
+    x0[i] = std::min(std::max(x0[i], RealMin), RealUB);
+  }
+
+  return x0;
+}
+
+#endif
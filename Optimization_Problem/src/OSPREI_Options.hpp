@@ -0,0 +1,151 @@
+// This code is published under the Eclipse Public License.
+// If you have not obtained a copy of the EPL, you can find the license (version 2.0) at
+// https://www.eclipse.org/legal/epl-2.0/
+//
+// Authors:  Daniel Doehring                  RWTH Aachen University 2022-11-20
+
+#ifndef __OSPREI_OPTIONS_HPP__
+#define __OSPREI_OPTIONS_HPP__
+
+#include "IpIpoptApplication.hpp"
+
+using namespace Ipopt;
+
+/*
+Options specific to OSPREI. These are registered with Ipopt such that they can be set 
+in the very same parameter files (Roots_Real.opt, Roots_RealImag.opt) as the Ipopt options.
+Must be called before 'app->Initialize()', which reads the parameter file.
+*/
+inline void register_OSPREI_options(const SmartPtr<RegisteredOptions>& roptions) {
+  roptions->SetRegisteringCategory("OSPREI");
+
+  /// Input ///
+  roptions->AddLowerBoundedNumberOption("eigval_dedup_tol",
+    "Merge eigenvalues which differ in real and imaginary part by at most this value (0: no merging).",
+    0., false, 0.);
+
+  /// Termination ///
+  roptions->AddLowerBoundedNumberOption("time_budget",
+    "Wall-clock time (seconds) per run (all solves) after which the best iterate found so far is returned (0: unlimited).",
+    0., false, 0.);
+  roptions->AddLowerBoundedIntegerOption("stagnation_iter",
+    "Stop if the best timestep did not improve over this number of iterations (0: off).",
+    0, 0);
+  roptions->AddLowerBoundedNumberOption("stagnation_tol",
+    "Relative increase of the best timestep which counts as improvement.",
+    0., false, 1e-6);
+  roptions->AddLowerBoundedNumberOption("stagnation_feas_tol",
+    "Stagnation is only checked once the best iterate violates the constraints by at most this value.",
+    0., false, 1e-8);
+
+  roptions->AddStringOption3("result_format",
+    "Output of the results",
+    "text",
+    "text", "One text file per quantity (Real_Optimized_S.txt, PE_S.txt, gamma_S.txt, ...)",
+    "bundle", "JSON manifest and binary blob Result_<Real|RealImag>_S.json/.bin",
+    "both", "Text files and result bundle",
+    "The bundle contains roots, timestep, multipliers, constraint values and (for Roots_RealImag) the "
+    "multi-precision coefficients as double-double. Chained runs read the bundle if present.");
+
+  roptions->AddLowerBoundedIntegerOption("checkpoint_interval",
+    "Write a checkpoint (Checkpoint_<Real|RealImag>_S.bin) every this many iterations (0: off). Restart with '--resume'.",
+    0, 0);
+
+  /// Warmstart ///
+  roptions->AddStringOption2("warm_start_persistence",
+    "Store the final primal-dual solution in a binary file (keyed by type, S, p, S_ref, dt_ref) and "
+    "warmstart from it in subsequent runs.",
+    "no",
+    "no", "Start from the usual initial guess",
+    "yes", "Store and reuse primal-dual solutions",
+    "If a stored solution is found, 'warm_start_init_point' is set to 'yes' automatically. "
+    "Multipliers are only reused if the number of constraints (eigenvalues) did not change.");
+
+  roptions->AddStringOption1("warm_start_database",
+    "Directory of the database of optimized root distributions (empty: no database).",
+    "",
+    "*", "Any directory name",
+    "Roots_Real.exe starts from the nearest stored solution (similar spectrum shape, same p, close S) "
+    "instead of the arc length distribution and appends its own solution.");
+  roptions->AddLowerBoundedNumberOption("warm_start_database_max_dist",
+    "Records farther away (shape distance plus 0.1 |log2(S_record/S)|) are not used for initialization.",
+    0., false, 0.5);
+
+  /// Result cache ///
+  roptions->AddStringOption1("result_cache_dir",
+    "Directory of the content-addressed cache of solved polynomials (empty: no caching).",
+    "",
+    "*", "Any directory name",
+    "Entries are keyed by a hash of S, p, S_ref, dt_ref and the contents of spectrum, hull, parameter and "
+    "initialization files. On a hit, the result files are restored without solving. Use Roots_Cache.exe to list and prune.");
+
+  /// Semi-infinite (exchange) formulation ///
+  roptions->AddLowerBoundedIntegerOption("sip_initial_samples",
+    "Number of equidistant (arc length) samples of the spectrum envelope used in the first exchange iteration.",
+    2, 32);
+  roptions->AddLowerBoundedNumberOption("sip_tol",
+    "Accepted violation of |R(z)| <= 1 along the spectrum envelope.",
+    0., false, 1e-8);
+  roptions->AddLowerBoundedIntegerOption("sip_max_exchange_iter",
+    "Maximum number of exchange iterations (re-solves with added points).",
+    1, 50);
+  roptions->AddLowerBoundedIntegerOption("sip_max_added_points",
+    "Maximum number of points added per exchange iteration (the largest violations are taken).",
+    1, 16);
+
+  /// Aggregated stability constraints (Roots_Real, Roots_RealImag) ///
+  roptions->AddStringOption3("stab_constr_aggregation",
+    "Aggregate the stability constraints |R(z_i)| <= 1 over blocks of eigenvalues into smooth constraints.",
+    "none",
+    "none", "One constraint per eigenvalue",
+    "ks", "Kreisselmeier-Steinhauser function per block",
+    "pnorm", "p-norm per block",
+    "The aggregation parameter is tightened by continuation, followed by a final solve with the exact constraints.");
+  roptions->AddLowerBoundedIntegerOption("aggregation_blocks",
+    "Number of blocks (of eigenvalues with neighboring real parts) that are aggregated.",
+    1, 8);
+  roptions->AddLowerBoundedNumberOption("aggregation_parameter",
+    "Initial aggregation parameter (rho for KS, P for p-norm).",
+    0., true, 50.);
+  roptions->AddLowerBoundedNumberOption("aggregation_parameter_factor",
+    "Factor by which the aggregation parameter is increased in every continuation step.",
+    1., false, 4.);
+  roptions->AddLowerBoundedIntegerOption("aggregation_continuation_steps",
+    "Number of aggregated solves before the final solve with the exact constraints.",
+    1, 3);
+
+  /// Coarse-to-fine multi-resolution solve ///
+  roptions->AddLowerBoundedIntegerOption("multires_levels",
+    "Number of levels of the spectrum pyramid (1: only the full spectrum).",
+    1, 3);
+  roptions->AddLowerBoundedIntegerOption("multires_coarsening",
+    "Ratio of the number of eigenvalues of neighboring levels.",
+    2, 8);
+
+  /// Stage-count continuation (Roots_Real) ///
+  roptions->AddLowerBoundedIntegerOption("stage_continuation_step",
+    "Increment of the number of stages between two continuation steps (even).",
+    2, 2);
+
+  /// Multi-start (Roots_Real) ///
+  roptions->AddLowerBoundedIntegerOption("multistart_starts",
+    "Number of starting root distributions (arc length, Chebyshev-like, previous solution, random perturbations).",
+    1, 8);
+  roptions->AddLowerBoundedIntegerOption("multistart_processes",
+    "Maximum number of concurrently solved starts (0: number of hardware threads).",
+    0, 0);
+  roptions->AddLowerBoundedNumberOption("multistart_perturbation",
+    "Amplitude of the random perturbations relative to the spacing of neighboring roots.",
+    0., false, 0.5);
+  roptions->AddLowerBoundedIntegerOption("multistart_seed",
+    "Seed for the random perturbations.",
+    0, 42);
+  roptions->AddLowerBoundedNumberOption("multistart_abort_margin",
+    "Starts whose timestep is smaller than (1 - margin) times the best feasible timestep are aborted.",
+    0., false, 0.05);
+  roptions->AddLowerBoundedIntegerOption("multistart_abort_iter",
+    "Minimum number of iterations before a start may be aborted.",
+    0, 20);
+}
+
+#endif
@@ -11,6 +11,9 @@
 
 #include "Interpolation.hpp"
 
+// Same signatures as in 'OrderConstraints_RealImag.hpp' => Separate namespace (both may be linked into one executable)
+namespace OrderConstr_Real {
+
 // NOTE: The constraints act on the pseudo/lower-degree polynomial!
 
 /*
@@ -881,4 +884,6 @@ T FourthOrder(const std::vector<T>& x, const int NumRoots,
   return g;
 }
 
-#endif
\ No newline at end of file
+} // namespace OrderConstr_Real
+
+#endif
@@ -11,6 +11,9 @@
 
 #include "Interpolation.hpp"
 
+// Same signatures as in 'OrderConstraints_Real.hpp' => Separate namespace (both may be linked into one executable)
+namespace OrderConstr_RealImag {
+
 // NOTE: The constraints act on the pseudo/lower-degree polynomial!
 
 /*
@@ -882,4 +885,6 @@ T FourthOrder(const std::vector<T>& xy, const int NumRoots,
   return g;
 }
 
-#endif
\ No newline at end of file
+} // namespace OrderConstr_RealImag
+
+#endif
@@ -34,8 +34,14 @@
 // 18 Digits
 //using MP_Real = long double;
 
+#if defined(MP_REAL_DOUBLE_DOUBLE)
+// 32 Digits: Double-double in hardware, much faster than 'cpp_bin_float_quad'
+#include "DoubleDouble.hpp"
+using MP_Real = DoubleDouble;
+#else
 // 33 Digits:
 using MP_Real = boost::multiprecision::cpp_bin_float_quad;
+#endif
 
 // 71 Digits:
 //using MP_Real = boost::multiprecision::cpp_bin_float_oct;
@@ -114,7 +120,8 @@ std::vector<MP_Real> ComputeCoeffs(const bool OddDegree, const int ConsOrder, co
 }
 
 // Compute SE Factors based on observation
-std::vector<MP_Real> Compute_SE_Factors(const int NumStages, const int NumStageEvals, const int ConsOrder) {
+std::vector<MP_Real> Compute_SE_Factors(const int NumStages, const int NumStageEvals, const int ConsOrder,
+                                        const bool WriteFile = true) {
   std::vector<MP_Real> c(NumStages);
 
   for(size_t i = 0; i < NumStages; i++)
@@ -125,6 +132,9 @@ std::vector<MP_Real> Compute_SE_Factors(const int NumStages, const int NumStageE
     SE_Factors[i] = c[NumStages - i - 2];
   }
 
+  if(!WriteFile)
+    return SE_Factors;
+
   std::ofstream SE_File("SE_Factors" + std::to_string(NumStages) + "_" + std::to_string(NumStageEvals) + ".txt");
   for(size_t i = 0; i < NumStageEvals - ConsOrder; i++) {
     std::stringstream StringStr; // On purpose within loop (automatic reset)
@@ -142,155 +152,166 @@ std::vector<MP_Real> Compute_SE_Factors(const int NumStages, const int NumStageE
 }
 
 
-// Chose float_type sinze even long long int runs out of "space" at ~22 digits
+/*
+Stability polynomial of the P-ERK methods in nested (Horner) form
+
+  P(z) = 1 + z (1 + z (g_2 + ... + z (g_p + z a_1 (SE_1 + z a_2 (SE_2 + ... + z a_K SE_K)))))
+
+with g_i the monomial coefficients (or 1/i! for the Taylor part), K = NumStageEvals - ConsOrder.
+The coefficients are set up once per (a, SE_Factors) and then reused for all eigenvalues and timesteps.
+Keeping the products of the a's unevaluated checks exactly what the integrator computes, i.e., the loss of accuracy
+in the a's (double) shows up as in the product form z_power *= z * a[...].
+*/
 template<typename float_type>
-inline float_type factorial(const size_t n, const std::vector<float_type>& TellCppWhatTypeToUse) {
-  float_type res = 1.0;
-  for(int i = 1; i <= n; i++)
-    res *= i;
-  return res;
+struct StabPnomTable {
+  std::vector<float_type> Coeffs;  // 1, 1, g_2, ..., g_p, SE_1, ..., SE_K
+  std::vector<float_type> Factors; // a_1, ..., a_K
+  int ConsOrder;
+};
+
+template<typename float_type>
+StabPnomTable<float_type> StabPnom_Table(const int NumStageEvals, const int ConsOrder,
+                                         const std::vector<float_type>& MonCoeffs,
+                                         const std::vector<float_type>& a, const std::vector<float_type>& SE_Factors) {
+  StabPnomTable<float_type> Table;
+  Table.ConsOrder = ConsOrder;
+  Table.Coeffs = {1., 1.};
+  for(int i = 2; i <= ConsOrder; i++)
+    Table.Coeffs.push_back(MonCoeffs[i-1]);
+
+  Table.Coeffs.insert(Table.Coeffs.end(), SE_Factors.begin(), SE_Factors.begin() + (NumStageEvals - ConsOrder));
+  Table.Factors.assign(a.begin(), a.begin() + (NumStageEvals - ConsOrder));
+
+  return Table;
 }
 
+// Taylor coefficients 1/i! up to the order of consistency, computed once instead of per eigenvalue
 template<typename float_type>
-void CheckStability(const int NumStages, const int NumStageEvals, const int ConsOrder,
-                    const std::vector<float_type>& MonCoeffs,
-                    const std::vector<float_type>& a, const std::vector<float_type>& SE_Factors,
-                    const int NumEigVals,
-                    const std::vector<double>& RealEigValsScaled, const std::vector<double>& ImagEigValsScaled,
-                    const double dtScaling) {
+StabPnomTable<float_type> StabPnom_Table(const int NumStageEvals, const int ConsOrder,
+                                         const std::vector<float_type>& a, const std::vector<float_type>& SE_Factors) {
+  std::vector<float_type> InvFactorials(ConsOrder, 1.);
+  for(int i = 2; i <= ConsOrder; i++)
+    InvFactorials[i-1] = InvFactorials[i-2] / i;
 
-  std::cout << std::setprecision(std::numeric_limits<float_type>::digits10);
-  std::complex<float_type> z, z_power, StabPnom;
-  float_type AbsDet;
-  for(size_t i = 0; i < NumEigVals; i++) {
-    z = std::complex<float_type>(RealEigValsScaled[i]*dtScaling, ImagEigValsScaled[i]*dtScaling);
-
-    StabPnom = std::complex<float_type>(1., 0.) + z;
-    z_power = z;
-    for (size_t i = 2; i <= ConsOrder; i++) {
-      z_power *= z;
-      StabPnom += z_power * MonCoeffs[i-1];
+  return StabPnom_Table(NumStageEvals, ConsOrder, InvFactorials, a, SE_Factors);
+}
+
+/*
+|P(z)| for a batch of eigenvalues z = dtScaling * lambda. Blocks of eigenvalues run through the Horner scheme
+simultaneously, i.e., every coefficient is loaded once per block and the independent recursions of the block can be
+interleaved (vectorized for float_type = double).
+*/
+template<typename float_type>
+void AbsStabPnom(const StabPnomTable<float_type>& Table, const int NumEigVals,
+                 const std::vector<double>& RealEigValsScaled, const std::vector<double>& ImagEigValsScaled,
+                 const float_type dtScaling, std::vector<float_type>& AbsVals) {
+  constexpr int BlockSize = 8;
+  const int Degree = Table.Coeffs.size() - 1;
+  AbsVals.resize(NumEigVals);
+
+  float_type zRe[BlockSize], zIm[BlockSize], tRe[BlockSize], tIm[BlockSize];
+  for(int Start = 0; Start < NumEigVals; Start += BlockSize) {
+    const int Size = std::min(BlockSize, NumEigVals - Start);
+    for(int j = 0; j < Size; j++) {
+      zRe[j] = RealEigValsScaled[Start + j] * dtScaling;
+      zIm[j] = ImagEigValsScaled[Start + j] * dtScaling;
+      tRe[j] = Table.Coeffs[Degree];
+      tIm[j] = 0.;
     }
 
-    for (size_t i = ConsOrder + 1; i <= NumStageEvals; i++) {
-      z_power *= z * a[i - (ConsOrder + 1)];
-      StabPnom += z_power * SE_Factors[i-(ConsOrder + 1)];
-      /*
-      std::cout << z << std::endl << z_power << std::endl << a[i - (ConsOrder + 1)] << std::endl 
-                << SE_Factors[i-(ConsOrder + 1)] << std::endl << std::endl;
-      */
+    // P-ERK part: t <- SE_k + z a_k t
+    for(int i = Degree - 1; i >= Table.ConsOrder; i--) {
+      const float_type& Factor = Table.Factors[i - Table.ConsOrder];
+      for(int j = 0; j < Size; j++) {
+        const float_type Re = Factor * tRe[j], Im = Factor * tIm[j];
+        tRe[j] = Table.Coeffs[i] + zRe[j] * Re - zIm[j] * Im;
+        tIm[j] = zRe[j] * Im + zIm[j] * Re;
+      }
+    }
+    // Monomial part: t <- g_i + z t
+    for(int i = std::min(Table.ConsOrder, Degree) - 1; i >= 0; i--) {
+      for(int j = 0; j < Size; j++) {
+        const float_type Re = tRe[j];
+        tRe[j] = Table.Coeffs[i] + zRe[j] * Re - zIm[j] * tIm[j];
+        tIm[j] = zRe[j] * tIm[j] + zIm[j] * Re;
+      }
     }
 
-    //AbsDet = std::abs(AbsDet); // Does not compile => Manual implementation
-    AbsDet = sqrt(real(StabPnom)*real(StabPnom) + imag(StabPnom)*imag(StabPnom)); // Seems to be the right thing
-    if(AbsDet > static_cast<float_type>(1.))
-      std::cout << i <<"'th eigenvalue violates constraint with stability polynomial value: "
-                << std::endl << AbsDet << std::endl << std::endl;
+    for(int j = 0; j < Size; j++)
+      AbsVals[Start + j] = sqrt(tRe[j] * tRe[j] + tIm[j] * tIm[j]); // std::abs does not compile for all types
   }
 }
 
 template<typename float_type>
-void CheckStability(const int NumStages, const int NumStageEvals, const int ConsOrder,
-                    const std::vector<float_type>& a, const std::vector<float_type>& SE_Factors,
-                    const int NumEigVals,
+void CheckStability(const StabPnomTable<float_type>& Table, const int NumEigVals,
                     const std::vector<double>& RealEigValsScaled, const std::vector<double>& ImagEigValsScaled,
                     const double dtScaling) {
 
+  std::vector<float_type> AbsVals;
+  AbsStabPnom(Table, NumEigVals, RealEigValsScaled, ImagEigValsScaled, static_cast<float_type>(dtScaling), AbsVals);
+
   std::cout << std::setprecision(std::numeric_limits<float_type>::digits10);
-  std::complex<float_type> z, z_power, StabPnom;
-  float_type AbsDet;
-  for(size_t i = 0; i < NumEigVals; i++) {
-    z = std::complex<float_type>(RealEigValsScaled[i]*dtScaling, ImagEigValsScaled[i]*dtScaling);
-
-    StabPnom = std::complex<float_type>(1., 0.) + z;
-    z_power = z;
-    for (size_t i = 2; i <= ConsOrder; i++) {
-      z_power *= z;
-      StabPnom += z_power / factorial(i, a);
-    }
+  for(int i = 0; i < NumEigVals; i++)
+    if(AbsVals[i] > static_cast<float_type>(1.))
+      std::cout << i <<"'th eigenvalue violates constraint with stability polynomial value: "
+                << std::endl << AbsVals[i] << std::endl << std::endl;
+}
 
-    for (size_t i = ConsOrder + 1; i <= NumStageEvals; i++) {
-      z_power *= z * a[i - (ConsOrder + 1)];
-      StabPnom += z_power * SE_Factors[i-(ConsOrder + 1)];
-      /*
-      std::cout << z << std::endl << z_power << std::endl << a[i - (ConsOrder + 1)] << std::endl 
-                << SE_Factors[i-(ConsOrder + 1)] << std::endl << std::endl;
-      */
-    }
+template<typename float_type>
+void CheckStability(const int NumStageEvals, const int ConsOrder,
+                    const std::vector<float_type>& MonCoeffs,
+                    const std::vector<float_type>& a, const std::vector<float_type>& SE_Factors,
+                    const int NumEigVals,
+                    const std::vector<double>& RealEigValsScaled, const std::vector<double>& ImagEigValsScaled,
+                    const double dtScaling) {
+  CheckStability(StabPnom_Table(NumStageEvals, ConsOrder, MonCoeffs, a, SE_Factors), NumEigVals,
+                 RealEigValsScaled, ImagEigValsScaled, dtScaling);
+}
 
-    //AbsDet = std::abs(AbsDet); // Does not compile => Manual implementation
-    AbsDet = sqrt(real(StabPnom)*real(StabPnom) + imag(StabPnom)*imag(StabPnom)); // Seems to be the right thing
-    if(AbsDet > static_cast<float_type>(1.))
-      std::cout << i <<"'th eigenvalue violates constraint with stability polynomial value: "
-                << std::endl << AbsDet << std::endl << std::endl;
-  }
+template<typename float_type>
+void CheckStability(const int NumStageEvals, const int ConsOrder,
+                    const std::vector<float_type>& a, const std::vector<float_type>& SE_Factors,
+                    const int NumEigVals,
+                    const std::vector<double>& RealEigValsScaled, const std::vector<double>& ImagEigValsScaled,
+                    const double dtScaling) {
+  CheckStability(StabPnom_Table(NumStageEvals, ConsOrder, a, SE_Factors), NumEigVals,
+                 RealEigValsScaled, ImagEigValsScaled, dtScaling);
 }
 
 template<typename float_type>
-float_type MaxAbsPnom(const int NumStages, const int NumStageEvals, const int ConsOrder,
-                      const std::vector<float_type>& a, const std::vector<float_type>& SE_Factors,
-                      const int NumEigVals,
+float_type MaxAbsPnom(const StabPnomTable<float_type>& Table, const int NumEigVals,
                       const std::vector<double>& RealEigValsScaled, const std::vector<double>& ImagEigValsScaled,
                       const float_type dtScaling) {
-  std::complex<float_type> z, z_power, StabPnom;
-  float_type AbsDet, AbsDetMax = 0.;
-  for(size_t i = 0; i < NumEigVals; i++) {
-    z = std::complex<float_type>(RealEigValsScaled[i] * dtScaling, ImagEigValsScaled[i] * dtScaling);
-
-    StabPnom = std::complex<float_type>(1., 0.) + z;
-    z_power = z;
-    for (size_t i = 2; i <= ConsOrder; i++) {
-      z_power *= z;
-      StabPnom += z_power / factorial(i, a);
-    }
-
-    for (size_t i = ConsOrder + 1; i <= NumStageEvals; i++) {
-      z_power *= z * a[i - (ConsOrder + 1)];
-
-      StabPnom += z_power * SE_Factors[i-(ConsOrder + 1)];
-    }
+  std::vector<float_type> AbsVals;
+  AbsStabPnom(Table, NumEigVals, RealEigValsScaled, ImagEigValsScaled, dtScaling, AbsVals);
 
-    //AbsDet = std::abs(AbsDet); // Does not compile => Manual implementation
-    AbsDet = sqrt(real(StabPnom)*real(StabPnom) + imag(StabPnom)*imag(StabPnom)); // Seems to be the right thing
+  float_type AbsDetMax = 0.;
+  for(const float_type& AbsDet : AbsVals)
     if(AbsDet > AbsDetMax)
       AbsDetMax = AbsDet;
-  }
 
   return AbsDetMax;
 }
 
 template<typename float_type>
-float_type MaxAbsPnom(const int NumStages, const int NumStageEvals, const int ConsOrder,
-                      const std::vector<float_type>& MonCoeffs,
+float_type MaxAbsPnom(const int NumStageEvals, const int ConsOrder,
                       const std::vector<float_type>& a, const std::vector<float_type>& SE_Factors,
                       const int NumEigVals,
                       const std::vector<double>& RealEigValsScaled, const std::vector<double>& ImagEigValsScaled,
                       const float_type dtScaling) {
-  std::complex<float_type> z, z_power, StabPnom;
-  float_type AbsDet, AbsDetMax = 0.;
-  for(size_t i = 0; i < NumEigVals; i++) {
-    z = std::complex<float_type>(RealEigValsScaled[i] * dtScaling, ImagEigValsScaled[i] * dtScaling);
-
-    StabPnom = std::complex<float_type>(1., 0.) + z;
-    z_power = z;
-    for (size_t i = 2; i <= ConsOrder; i++) {
-      z_power *= z;
-      StabPnom += z_power * MonCoeffs[i-1];
-    }
-
-    for (size_t i = ConsOrder + 1; i <= NumStageEvals; i++) {
-      z_power *= z * a[i - (ConsOrder + 1)];
-
-      StabPnom += z_power * SE_Factors[i-(ConsOrder + 1)];
-    }
-
-    //AbsDet = std::abs(AbsDet); // Does not compile => Manual implementation
-    AbsDet = sqrt(real(StabPnom)*real(StabPnom) + imag(StabPnom)*imag(StabPnom)); // Seems to be the right thing
-    if(AbsDet > AbsDetMax)
-      AbsDetMax = AbsDet;
-  }
+  return MaxAbsPnom(StabPnom_Table(NumStageEvals, ConsOrder, a, SE_Factors), NumEigVals,
+                    RealEigValsScaled, ImagEigValsScaled, dtScaling);
+}
 
-  return AbsDetMax;
+template<typename float_type>
+float_type MaxAbsPnom(const int NumStageEvals, const int ConsOrder,
+                      const std::vector<float_type>& MonCoeffs,
+                      const std::vector<float_type>& a, const std::vector<float_type>& SE_Factors,
+                      const int NumEigVals,
+                      const std::vector<double>& RealEigValsScaled, const std::vector<double>& ImagEigValsScaled,
+                      const float_type dtScaling) {
+  return MaxAbsPnom(StabPnom_Table(NumStageEvals, ConsOrder, MonCoeffs, a, SE_Factors), NumEigVals,
+                    RealEigValsScaled, ImagEigValsScaled, dtScaling);
 }
 
 /* NOTE: Seems unreliable, i.e., assumption of monotonicity in timestep as taken in 
@@ -298,7 +319,7 @@ float_type MaxAbsPnom(const int NumStages, const int NumStageEvals, const int Co
    is not observed in practice!
 */ 
 template<typename float_type>
-float_type FindMaxTimeStep(const int NumStages, const int NumStageEvals, const int ConsOrder,
+float_type FindMaxTimeStep(const int NumStageEvals, const int ConsOrder,
                            const std::vector<float_type>& a, const std::vector<float_type>& SE_Factors,
                            const int NumEigVals,
                            const std::vector<double>& RealEigValsScaled, const std::vector<double>& ImagEigValsScaled,
@@ -309,11 +330,11 @@ float_type FindMaxTimeStep(const int NumStages, const int NumStageEvals, const i
   float_type dtScalMin = 0.;
   const double dtScalEps = 1e-12;
 
+  const StabPnomTable<float_type> Table = StabPnom_Table(NumStageEvals, ConsOrder, a, SE_Factors);
   float_type Violation, dtScaling;
   while(dtScalMax - dtScalMin > dtScalEps) {
     dtScaling = 0.5 * (dtScalMax + dtScalMin);
-    Violation = MaxAbsPnom(NumStages, NumStageEvals, ConsOrder, a, SE_Factors, NumEigVals, 
-                           RealEigValsScaled, ImagEigValsScaled, dtScaling);
+    Violation = MaxAbsPnom(Table, NumEigVals, RealEigValsScaled, ImagEigValsScaled, dtScaling);
 
     if(Violation < static_cast<float_type>(1.0))
       dtScalMin = dtScaling;
@@ -329,7 +350,7 @@ float_type FindMaxTimeStep(const int NumStages, const int NumStageEvals, const i
    is not observed in practice!
 */ 
 template<typename float_type>
-float_type FindMaxTimeStep(const int NumStages, const int NumStageEvals, const int ConsOrder,
+float_type FindMaxTimeStep(const int NumStageEvals, const int ConsOrder,
                            const std::vector<float_type>& MonCoeffs,
                            const std::vector<float_type>& a, const std::vector<float_type>& SE_Factors,
                            const int NumEigVals,
@@ -341,11 +362,11 @@ float_type FindMaxTimeStep(const int NumStages, const int NumStageEvals, const i
   float_type dtScalMin = 0.;
   const double dtScalEps = 1e-12;
 
+  const StabPnomTable<float_type> Table = StabPnom_Table(NumStageEvals, ConsOrder, MonCoeffs, a, SE_Factors);
   float_type Violation, dtScaling;
   while(dtScalMax - dtScalMin > dtScalEps) {
     dtScaling = 0.5 * (dtScalMax + dtScalMin);
-    Violation = MaxAbsPnom(NumStages, NumStageEvals, ConsOrder, MonCoeffs, a, SE_Factors, 
-                           NumEigVals, RealEigValsScaled, ImagEigValsScaled, dtScaling);
+    Violation = MaxAbsPnom(Table, NumEigVals, RealEigValsScaled, ImagEigValsScaled, dtScaling);
 
     if(Violation < static_cast<float_type>(1.0))
       dtScalMin = dtScaling;
@@ -360,7 +381,9 @@ void compute_a_coeffs(const int NumStages, const int NumStageEvals, const bool O
                       const std::vector<double>& RootsReal, const std::vector<double>& RootsImag,
                       const int NumEigVals,
                       const std::vector<double>& RealEigValsScaled, const std::vector<double>& ImagEigValsScaled,
-                      const double dt, const double dtExp) {
+                      const double dt, const double dtExp,
+                      const bool WriteFiles = true, std::vector<MP_Real>* gamma_Out = NULL, 
+                      std::vector<MP_Real>* a_Out = NULL, std::vector<MP_Real>* SE_Factors_Out = NULL) {
 
   std::cout << std::endl << std::endl << std::endl << "### Runge-Kutta Coefficient Computing ###" << std::endl;
 
@@ -369,8 +392,13 @@ void compute_a_coeffs(const int NumStages, const int NumStageEvals, const bool O
 
   const std::vector<MP_Real> MonCoeffs = ComputeCoeffs(OddDegree, ConsOrder, NumStages, RootsReal, RootsImag);
 
-  std::ofstream MC_file("gamma_" + std::to_string(NumStages) + ".txt");
-  for(size_t i = 0; i < NumStages; i++) {
+  if(gamma_Out)
+    *gamma_Out = MonCoeffs;
+
+  std::ofstream MC_file;
+  if(WriteFiles)
+    MC_file.open("gamma_" + std::to_string(NumStages) + ".txt");
+  for(size_t i = 0; i < NumStages && WriteFiles; i++) {
     std::stringstream StringStr; // On purpose within loop (automatic reset)
     // Double precision
     //StringStr << std::setprecision(std::numeric_limits<Number>::max_digits10);
@@ -387,7 +415,9 @@ void compute_a_coeffs(const int NumStages, const int NumStageEvals, const bool O
   MC_file.close();
 
   
-  const std::vector<MP_Real> SE_Factors = Compute_SE_Factors(NumStages, NumStageEvals, ConsOrder);
+  const std::vector<MP_Real> SE_Factors = Compute_SE_Factors(NumStages, NumStageEvals, ConsOrder, WriteFiles);
+  if(SE_Factors_Out)
+    *SE_Factors_Out = SE_Factors;
 
   std::vector<MP_Real> a_MP = std::vector<MP_Real>(MonCoeffs.begin() + ConsOrder, MonCoeffs.end());
   for(size_t i = 0; i < NumStageEvals - ConsOrder; i++) {
@@ -421,10 +451,10 @@ void compute_a_coeffs(const int NumStages, const int NumStageEvals, const bool O
   */
 
   std::cout << std::endl << "Checking stab. constr. computed from a-coeffs in Multiprecision " << std::endl << std::endl;
-  CheckStability(NumStages, NumStageEvals, ConsOrder, MonCoeffs, a_MP, SE_Factors, NumEigVals, 
+  CheckStability(NumStageEvals, ConsOrder, MonCoeffs, a_MP, SE_Factors, NumEigVals, 
                  RealEigValsScaled, ImagEigValsScaled, dt/dtExp);
 
-  const MP_Real dtScaling_MP = FindMaxTimeStep(NumStages, NumStageEvals, ConsOrder, MonCoeffs, a_MP, SE_Factors, 
+  const MP_Real dtScaling_MP = FindMaxTimeStep(NumStageEvals, ConsOrder, MonCoeffs, a_MP, SE_Factors, 
                                                NumEigVals, RealEigValsScaled, ImagEigValsScaled, dt/dtExp);
 
   std::cout << std::endl << "In theory optimal timestep degenerates to: " << dtScaling_MP 
@@ -435,10 +465,10 @@ void compute_a_coeffs(const int NumStages, const int NumStageEvals, const bool O
   std::vector<double> SE_Factors_DBL(SE_Factors.begin(), SE_Factors.end());
 
   std::cout << std::endl << "Checking stab. constr. computed from a-coeffs in double " << std::endl << std::endl;
-  CheckStability(NumStages, NumStageEvals, ConsOrder, a_DBL, SE_Factors_DBL, NumEigVals, 
+  CheckStability(NumStageEvals, ConsOrder, a_DBL, SE_Factors_DBL, NumEigVals, 
                  RealEigValsScaled, ImagEigValsScaled, dt/dtExp);
   
-  const double dtScaling = FindMaxTimeStep(NumStages, NumStageEvals, ConsOrder, a_DBL, SE_Factors_DBL, NumEigVals, 
+  const double dtScaling = FindMaxTimeStep(NumStageEvals, ConsOrder, a_DBL, SE_Factors_DBL, NumEigVals, 
                                            RealEigValsScaled, ImagEigValsScaled, dt/dtExp);
   std::cout << std::endl << "In theory optimal timestep degenerates to: " << dtScaling 
             << " of desired value, i.e., " << dtExp * dtScaling  << std::endl;
@@ -448,6 +478,11 @@ void compute_a_coeffs(const int NumStages, const int NumStageEvals, const bool O
   std::reverse(a_MP.begin(), a_MP.end());
   std::reverse(a_DBL.begin(), a_DBL.end());
 
+  if(a_Out)
+    *a_Out = a_MP;
+  if(!WriteFiles)
+    return;
+
   std::ofstream a_file("a_Unknown" + std::to_string(NumStageEvals) + ".txt");
   for(size_t i = 0; i < NumStageEvals - ConsOrder; i++) {
     std::stringstream StringStr; // On purpose within loop (automatic reset)
@@ -0,0 +1,322 @@
+// This code is published under the Eclipse Public License.
+// If you have not obtained a copy of the EPL, you can find the license (version 2.0) at
+// https://www.eclipse.org/legal/epl-2.0/
+//
+// Authors:  Daniel Doehring                  RWTH Aachen University 2022-11-20
+
+#ifndef __RESULTBUNDLE_HPP__
+#define __RESULTBUNDLE_HPP__
+
+#include <string>
+#include <vector>
+#include <utility>
+#include <fstream>
+#include <sstream>
+#include <iostream>
+#include <iomanip>
+#include <limits>
+#include <filesystem>
+#include <cstdint>
+#include <cctype>
+#include <algorithm>
+#include <iterator>
+
+#include "IO_Funcs.hpp" // For 'read_x0', 'read_PE'
+
+/*
+Result bundle (option 'result_format'): Instead of one text file per quantity, every solve writes
+'Result_<Real|RealImag>_<S>.bin' with all arrays back to back (little-endian double) and a JSON manifest
+'Result_<Real|RealImag>_<S>.json' listing name, type, offset (bytes) and count of every section, e.g.
+
+  {"name": "x", "type": "f64", "offset": 0, "count": 17}
+
+Type 'f64x2' denotes multi-precision values stored as unevaluated sums hi + lo of two doubles (double-double),
+i.e., 'count' pairs. Both files are written with a single write each, the manifest last.
+*/
+
+inline std::string ResultBundlePrefix(const std::string Problem, const int NumStages) {
+  return "./Result_" + Problem + "_" + std::to_string(NumStages);
+}
+
+class ResultBundle {
+public:
+  ResultBundle(const std::string Problem_, const int NumStages_, const int ConsOrder_) :
+    Problem(Problem_), NumStages(NumStages_), ConsOrder(ConsOrder_) {}
+
+  template <typename T>
+  void add(const std::string Name, const T* Values, const size_t Count) {
+    Sections.push_back({Name, "f64", Blob.size(), Count});
+    for(size_t i = 0; i < Count; i++)
+      append(static_cast<double>(Values[i]));
+  }
+
+  template <typename T>
+  void add(const std::string Name, const std::vector<T>& Values) {
+    add(Name, Values.data(), Values.size());
+  }
+
+  // Multi-precision values as double-double
+  template <typename MP>
+  void add_MP(const std::string Name, const std::vector<MP>& Values) {
+    Sections.push_back({Name, "f64x2", Blob.size(), Values.size()});
+    for(const MP& Value : Values) {
+      const double Hi = static_cast<double>(Value);
+      append(Hi);
+      append(static_cast<double>(Value - Hi));
+    }
+  }
+
+  bool write(const double Timestep) const {
+    const std::string Prefix = ResultBundlePrefix(Problem, NumStages);
+
+    std::ofstream BlobFile(Prefix + ".bin", std::ios::binary);
+    BlobFile.write(Blob.data(), Blob.size());
+    BlobFile.close();
+    if(!BlobFile)
+      return false;
+
+    std::stringstream Manifest;
+    Manifest << std::setprecision(std::numeric_limits<double>::max_digits10);
+    Manifest << "{\n"
+             << "  \"format\": \"OSPREI result bundle\",\n"
+             << "  \"version\": 1,\n"
+             << "  \"problem\": \"" << Problem << "\",\n"
+             << "  \"num_stages\": " << NumStages << ",\n"
+             << "  \"cons_order\": " << ConsOrder << ",\n"
+             << "  \"timestep\": " << Timestep << ",\n"
+             << "  \"blob\": \"" << std::filesystem::path(Prefix + ".bin").filename().string() << "\",\n"
+             << "  \"sections\": [\n";
+    for(size_t k = 0; k < Sections.size(); k++)
+      Manifest << "    {\"name\": \"" << Sections[k].Name << "\", \"type\": \"" << Sections[k].Type
+               << "\", \"offset\": " << Sections[k].Offset << ", \"count\": " << Sections[k].Count << "}"
+               << (k + 1 < Sections.size() ? ",\n" : "\n");
+    Manifest << "  ]\n}\n";
+
+    const std::string ManifestStr = Manifest.str();
+    std::ofstream ManifestFile(Prefix + ".json", std::ios::binary);
+    ManifestFile.write(ManifestStr.data(), ManifestStr.size());
+    ManifestFile.close();
+    return static_cast<bool>(ManifestFile);
+  }
+
+private:
+  struct Section {
+    std::string Name, Type;
+    size_t Offset, Count;
+  };
+
+  void append(const double Value) {
+    Blob.append(reinterpret_cast<const char*>(&Value), sizeof(double));
+  }
+
+  std::string Problem;
+  int NumStages, ConsOrder;
+
+  std::vector<Section> Sections;
+  std::string Blob;
+};
+
+/*
+Minimal JSON reader for the manifest: Only the sections in the array "sections" of the top-level object are extracted,
+all other values (of any type) are skipped. Keys are thus matched at object level only, never inside string values.
+*/
+struct BundleSection {
+  std::string Name, Type;
+  size_t Offset = 0, Count = 0;
+};
+
+inline void skip_JSON_WS(const std::string& JSON, size_t& Pos) {
+  while(Pos < JSON.size() && std::isspace(static_cast<unsigned char>(JSON[Pos])))
+    Pos++;
+}
+
+// Expects the next non-whitespace character to be 'c' and consumes it
+inline bool expect_JSON(const std::string& JSON, size_t& Pos, const char c) {
+  skip_JSON_WS(JSON, Pos);
+  if(Pos >= JSON.size() || JSON[Pos] != c)
+    return false;
+  Pos++;
+  return true;
+}
+
+// Escaped characters are taken literally (no unicode escapes in names written by 'ResultBundle::write')
+inline bool parse_JSON_String(const std::string& JSON, size_t& Pos, std::string& Value) {
+  if(!expect_JSON(JSON, Pos, '"'))
+    return false;
+  Value.clear();
+  for(; Pos < JSON.size(); Pos++) {
+    if(JSON[Pos] == '"') {
+      Pos++;
+      return true;
+    }
+    if(JSON[Pos] == '\\' && ++Pos == JSON.size())
+      return false;
+    Value += JSON[Pos];
+  }
+  return false;
+}
+
+// Numbers, true, false, null
+inline bool parse_JSON_Scalar(const std::string& JSON, size_t& Pos, std::string& Value) {
+  skip_JSON_WS(JSON, Pos);
+  const size_t Begin = Pos;
+  while(Pos < JSON.size() && JSON[Pos] != ',' && JSON[Pos] != '}' && JSON[Pos] != ']' && 
+        !std::isspace(static_cast<unsigned char>(JSON[Pos])))
+    Pos++;
+  Value = JSON.substr(Begin, Pos - Begin);
+  return Pos > Begin;
+}
+
+// Iterates the members of an object ('Member' called with the key, 'Pos' at its value) or elements of an array
+template <typename Func>
+bool parse_JSON_Members(const std::string& JSON, size_t& Pos, const bool Object, Func Member) {
+  const char Open = Object ? '{' : '[', Close = Object ? '}' : ']';
+  if(!expect_JSON(JSON, Pos, Open))
+    return false;
+  if(expect_JSON(JSON, Pos, Close))
+    return true;
+
+  std::string Key;
+  do {
+    if(Object && (!parse_JSON_String(JSON, Pos, Key) || !expect_JSON(JSON, Pos, ':')))
+      return false;
+    if(!Member(Key))
+      return false;
+  } while(expect_JSON(JSON, Pos, ','));
+
+  return expect_JSON(JSON, Pos, Close);
+}
+
+inline bool skip_JSON_Value(const std::string& JSON, size_t& Pos) {
+  skip_JSON_WS(JSON, Pos);
+  if(Pos >= JSON.size())
+    return false;
+
+  std::string Value;
+  switch(JSON[Pos]) {
+    case '"': return parse_JSON_String(JSON, Pos, Value);
+    case '{': return parse_JSON_Members(JSON, Pos, true,  [&](const std::string&) { return skip_JSON_Value(JSON, Pos); });
+    case '[': return parse_JSON_Members(JSON, Pos, false, [&](const std::string&) { return skip_JSON_Value(JSON, Pos); });
+    default:  return parse_JSON_Scalar(JSON, Pos, Value);
+  }
+}
+
+// Returns false for malformed manifests
+inline bool parse_BundleManifest(const std::string& Manifest, std::vector<BundleSection>& Sections) {
+  Sections.clear();
+  size_t Pos = 0;
+
+  auto SectionMember = [&](const std::string& Key) {
+    BundleSection& Section = Sections.back();
+    std::string Value;
+    if(Key == "name")
+      return parse_JSON_String(Manifest, Pos, Section.Name);
+    else if(Key == "type")
+      return parse_JSON_String(Manifest, Pos, Section.Type);
+    else if(Key == "offset" || Key == "count") {
+      if(!parse_JSON_Scalar(Manifest, Pos, Value) || Value.find_first_not_of("0123456789") != std::string::npos)
+        return false;
+      (Key == "offset" ? Section.Offset : Section.Count) = std::stoull(Value);
+      return true;
+    }
+    return skip_JSON_Value(Manifest, Pos);
+  };
+
+  return parse_JSON_Members(Manifest, Pos, true, [&](const std::string& Key) {
+    if(Key != "sections")
+      return skip_JSON_Value(Manifest, Pos);
+    return parse_JSON_Members(Manifest, Pos, false, [&](const std::string&) {
+      Sections.emplace_back();
+      return parse_JSON_Members(Manifest, Pos, true, SectionMember);
+    });
+  });
+}
+
+// Reads section 'Name' (type 'f64') of the bundle 'Prefix'. Returns false if bundle or section do not exist.
+template <typename T>
+bool read_ResultBundle(const std::string Prefix, const std::string Name, std::vector<T>& Values) {
+  std::ifstream ManifestFile(Prefix + ".json");
+  if(!ManifestFile)
+    return false;
+  const std::string Manifest((std::istreambuf_iterator<char>(ManifestFile)), std::istreambuf_iterator<char>());
+
+  std::vector<BundleSection> Sections;
+  if(!parse_BundleManifest(Manifest, Sections)) {
+    std::cout << "CARE: Malformed result bundle manifest " << Prefix << ".json" << std::endl;
+    return false;
+  }
+
+  auto It = std::find_if(Sections.begin(), Sections.end(), 
+                         [&](const BundleSection& Section) { return Section.Name == Name && Section.Type == "f64"; });
+  if(It == Sections.end())
+    return false;
+
+  std::ifstream BlobFile(Prefix + ".bin", std::ios::binary | std::ios::ate);
+  if(!BlobFile)
+    return false;
+  const size_t BlobSize = BlobFile.tellg();
+  // Section has to lie within the blob (checked without overflow)
+  if(It->Offset > BlobSize || It->Count > (BlobSize - It->Offset) / sizeof(double))
+    return false;
+
+  std::vector<double> Raw(It->Count);
+  BlobFile.seekg(It->Offset);
+  BlobFile.read(reinterpret_cast<char*>(Raw.data()), It->Count * sizeof(double));
+  if(!BlobFile)
+    return false;
+
+  Values.assign(Raw.begin(), Raw.end());
+  return true;
+}
+
+// Bundle and text output of one solve may coexist (result_format "both") or stem from different runs:
+// The more recently written one is used.
+inline bool prefer_ResultBundle(const std::string Prefix, const std::string TextFileName) {
+  std::error_code Error;
+  const auto BundleTime = std::filesystem::last_write_time(Prefix + ".json", Error);
+  if(Error)
+    return false;
+  const auto TextTime = std::filesystem::last_write_time(TextFileName, Error);
+  return Error || BundleTime >= TextTime;
+}
+
+// Chaining Roots_Real -> Roots_RealImag: Solution (roots, timestep) of Roots_Real padded with zeros to 'NumUnknowns'.
+// Newer of bundle and 'Real_Optimized_S.txt'. Returns false if neither exists.
+template <typename T>
+bool read_x0_Result(const int NumStages, std::vector<T>& x0, const int NumUnknowns) {
+  const std::string Prefix      = ResultBundlePrefix("Real", NumStages);
+  const std::string x0_FileName = "./Real_Optimized_" + std::to_string(NumStages) + ".txt";
+  if(prefer_ResultBundle(Prefix, x0_FileName) && read_ResultBundle(Prefix, "x", x0)) {
+    std::cout << "Read initial values from " << Prefix << ".json" << std::endl;
+    assert(x0.size() <= static_cast<size_t>(NumUnknowns));
+    x0.resize(NumUnknowns);
+    return true;
+  }
+
+  if(!std::filesystem::exists(x0_FileName))
+    return false;
+  read_x0(x0_FileName, x0, NumUnknowns);
+  return true;
+}
+
+// Chaining Roots_RealImag (S/2) -> Roots_Real (S): Real parts of the first 'NumPE' roots.
+// Newer of bundle and 'RealImag_Optimized_S.txt'. Returns false if neither exists.
+template <typename T>
+bool read_PE_Result(const int NumStages, const int NumPE, std::vector<T>& Real_PE) {
+  const std::string Prefix     = ResultBundlePrefix("RealImag", NumStages);
+  const std::string PEFileName = "./RealImag_Optimized_" + std::to_string(NumStages) + ".txt";
+  if(prefer_ResultBundle(Prefix, PEFileName) && read_ResultBundle(Prefix, "roots_real", Real_PE) && 
+     Real_PE.size() >= static_cast<size_t>(NumPE)) {
+    std::cout << "Read pseudo-extrema from " << Prefix << ".json" << std::endl;
+    Real_PE.resize(NumPE);
+    return true;
+  }
+
+  if(!std::filesystem::exists(PEFileName))
+    return false;
+  std::cout << "Read pseudo-extrema from " << PEFileName << std::endl;
+  read_PE(PEFileName, NumPE, Real_PE);
+  return true;
+}
+
+#endif // __RESULTBUNDLE_HPP__
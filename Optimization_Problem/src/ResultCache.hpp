@@ -0,0 +1,146 @@
+// This code is published under the Eclipse Public License.
+// If you have not obtained a copy of the EPL, you can find the license (version 2.0) at
+// https://www.eclipse.org/legal/epl-2.0/
+//
+// Authors:  Daniel Doehring                  RWTH Aachen University 2022-11-20
+
+#ifndef __RESULTCACHE_HPP__
+#define __RESULTCACHE_HPP__
+
+#include <string>
+#include <vector>
+#include <fstream>
+#include <sstream>
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <filesystem>
+#include <cstdint>
+#include <unistd.h> // getpid
+
+#include "WarmStartIO.hpp" // For 'FNV1a', 'write_WarmStart'
+
+/*
+Content-addressed on-disk cache of solved polynomials.
+The key is a hash of the problem type, S, p, S_ref, dt_ref and the contents of all input files
+(spectrum, hull, parameter file with the Ipopt options, files used for initialization, persisted warmstarts).
+Every entry is a directory <CacheDir>/<Key>/ holding the result files (roots, timestep, coefficients),
+the primal-dual solution in 'Solution.bin' (layout as for warmstart persistence) and a one line 'Meta.txt'.
+*/
+
+// Hash of the file contents. Missing files are hashed by name only, thus differ from empty files.
+inline uint64_t HashFile(const std::string FileName, uint64_t Hash) {
+  Hash = FNV1a(FileName.data(), FileName.size(), Hash);
+
+  std::ifstream File(FileName, std::ios::binary);
+  if(!File)
+    return Hash;
+
+  const char Present = 1;
+  Hash = FNV1a(&Present, 1, Hash);
+
+  // Fixed-size chunks: FNV-1a continues across chunk boundaries, i.e., same hash as for the whole content
+  char Buffer[1 << 16];
+  while(File.read(Buffer, sizeof(Buffer)) || File.gcount() > 0)
+    Hash = FNV1a(Buffer, File.gcount(), Hash);
+
+  return Hash;
+}
+
+// Persisted warmstarts (see 'WarmStartFileName') of this problem type and S, sorted by name.
+// Their signature requires the scaled spectrum, thus all of them are inputs (worst case: a cache miss).
+inline std::vector<std::string> WarmStartFiles(const std::string Problem, const int NumStages) {
+  const std::string Prefix = "WarmStart_" + Problem + "_" + std::to_string(NumStages) + "_";
+
+  std::vector<std::string> FileNames;
+  for(const std::filesystem::directory_entry& Entry : std::filesystem::directory_iterator(".")) {
+    const std::string Name = Entry.path().filename().string();
+    if(Entry.is_regular_file() && Name.compare(0, Prefix.size(), Prefix) == 0 && 
+       Entry.path().extension() == ".bin")
+      FileNames.push_back("./" + Name);
+  }
+  std::sort(FileNames.begin(), FileNames.end());
+
+  return FileNames;
+}
+
+inline std::string CacheKey(const std::string Problem, const int NumStages, const int ConsOrder, 
+                            const int NumStagesRef, const double dtRef, 
+                            const std::vector<std::string>& InputFiles) {
+  uint64_t Hash = FNV1a(Problem.data(), Problem.size());
+  Hash = FNV1a(&NumStages,    sizeof(NumStages),    Hash);
+  Hash = FNV1a(&ConsOrder,    sizeof(ConsOrder),    Hash);
+  Hash = FNV1a(&NumStagesRef, sizeof(NumStagesRef), Hash);
+  Hash = FNV1a(&dtRef,        sizeof(dtRef),        Hash);
+  for(const std::string& FileName : InputFiles)
+    Hash = HashFile(FileName, Hash);
+
+  std::stringstream Key;
+  Key << Problem << "_" << NumStages << "_" << std::hex << std::setw(16) << std::setfill('0') << Hash;
+  return Key.str();
+}
+
+// Files written by Roots_Real.exe and Roots_RealImag.exe, respectively
+inline std::vector<std::string> ResultFiles(const std::string Problem, const int NumStages) {
+  const std::string S = std::to_string(NumStages);
+  // Result bundle (if written)
+  const std::string Bundle = "Result_" + Problem + "_" + S;
+  if(Problem == "Real")
+    return {"Real_Optimized_" + S + ".txt", "PE_" + S + ".txt", Bundle + ".json", Bundle + ".bin"};
+  else
+    return {"RealImag_Optimized_" + S + ".txt", "PureReal" + S + ".txt", "TrueComplex" + S + ".txt",
+            "gamma_" + S + ".txt", "a_Unknown" + S + ".txt", "SE_Factors" + S + "_" + S + ".txt",
+            Bundle + ".json", Bundle + ".bin"};
+}
+
+// Copies the result files of a cached entry to the working directory. Returns false on a cache miss.
+inline bool restore_from_cache(const std::string CacheDir, const std::string Key, 
+                               const std::vector<std::string>& Files) {
+  const std::filesystem::path Entry = std::filesystem::path(CacheDir) / Key;
+  if(!std::filesystem::exists(Entry / "Meta.txt"))
+    return false;
+
+  for(const std::string& FileName : Files)
+    if(std::filesystem::exists(Entry / FileName))
+      std::filesystem::copy_file(Entry / FileName, FileName, std::filesystem::copy_options::overwrite_existing);
+
+  // Entries are pruned by last use
+  std::filesystem::last_write_time(Entry / "Meta.txt", std::filesystem::file_time_type::clock::now());
+
+  std::cout << "Result restored from cache entry " << Entry.string() << std::endl;
+  return true;
+}
+
+// Stores the result files of the working directory and the primal-dual solution as new entry.
+// The entry is assembled in a temporary directory and renamed, such that concurrent jobs never see partial entries.
+inline void store_in_cache(const std::string CacheDir, const std::string Key, const std::vector<std::string>& Files,
+                           const std::vector<double>& x, const std::vector<double>& zL, 
+                           const std::vector<double>& zU, const std::vector<double>& lambda, 
+                           const std::string Description) {
+  const std::filesystem::path Entry = std::filesystem::path(CacheDir) / Key;
+  const std::filesystem::path Temp  = std::filesystem::path(CacheDir) / (Key + ".tmp" + std::to_string(getpid()));
+  std::error_code Error;
+  std::filesystem::create_directories(Temp, Error);
+  if(Error) {
+    std::cout << "CARE: Could not create cache directory " << Temp.string() << std::endl;
+    return;
+  }
+
+  for(const std::string& FileName : Files)
+    if(std::filesystem::exists(FileName))
+      std::filesystem::copy_file(FileName, Temp / FileName, std::filesystem::copy_options::overwrite_existing);
+
+  write_WarmStart((Temp / "Solution.bin").string(), x, zL, zU, lambda);
+
+  std::ofstream MetaFile(Temp / "Meta.txt");
+  MetaFile << Description << "\n";
+  MetaFile.close();
+
+  std::filesystem::rename(Temp, Entry, Error);
+  if(Error) // E.g. entry has been stored by a concurrent job
+    std::filesystem::remove_all(Temp, Error);
+  else
+    std::cout << "Result stored in cache entry " << Entry.string() << std::endl;
+}
+
+#endif
@@ -22,8 +22,14 @@
 #include "RootDistribution.hpp"
 #include "StabConstraints_Real.hpp"
 #include "OrderConstraints_Real.hpp"
+#include "Aggregation.hpp"
+#include "WarmStartIO.hpp"
+#include "WarmStartDB.hpp"
+#include "Checkpoint.hpp"
+#include "ResultBundle.hpp"
 
 using namespace Ipopt;
+using namespace OrderConstr_Real;
 
 
 Roots_Real::Roots_Real(
@@ -31,7 +37,8 @@ Roots_Real::Roots_Real(
    const int ConsOrder_,
    const int NumStagesRef_, 
    const Number dtRef_,
-   const std::string EigValFileName
+   const std::string EigValFileName,
+   const Number DedupTol
 ) : NumStages(NumStages_), Degree(NumStages_), ConsOrder(ConsOrder_),
     NumStagesRef(NumStagesRef_), dtRef(dtRef_), dtExp((dtRef / NumStagesRef_) *  NumStages_)
 {
@@ -43,7 +50,7 @@ Roots_Real::Roots_Real(
   std::cout << "The expected maximal stable timestep is: " << dtExp  << std::endl << std::endl;
 
   NumEigVals = -1;
-  read_EigVals(EigValFileName, NumEigVals, RealEigValsScaled, ImagEigValsScaled);
+  read_EigVals(EigValFileName, NumEigVals, RealEigValsScaled, ImagEigValsScaled, DedupTol);
 
   for(size_t i = 0; i < NumEigVals; i++) {
     RealEigValsScaled[i] *= dtExp;
@@ -69,14 +76,11 @@ Roots_Real::Roots_Real(
   // Optimize timestep now as well
   NumUnknowns = NumRoots + 1;
 
-   std::string PE_HalfStagesFileName = "./RealImag_Optimized_" + std::to_string(NumStages/2) + ".txt";
-   if(std::filesystem::exists(PE_HalfStagesFileName)) {
+   std::vector<Number> Real_PE_HalfStagesScaled;
+   if(read_PE_Result(NumStages/2, NumStages/4, Real_PE_HalfStagesScaled)) {
       std::cout << "Use pseudo-extrema of " << std::to_string(NumStages/2) 
-                << " stage RKM for initialization, stored in file" 
-                << PE_HalfStagesFileName << std::endl << std::endl;
+                << " stage RKM for initialization" << std::endl << std::endl;
 
-      std::vector<Number> Real_PE_HalfStagesScaled;
-      read_PE(PE_HalfStagesFileName, NumStages/4, Real_PE_HalfStagesScaled);
       // Scale Pseudo-Extrema
       for(size_t i = 0; i < NumStages/4; i++)
          Real_PE_HalfStagesScaled[i] *= 2.0;
@@ -101,6 +105,19 @@ Roots_Real::Roots_Real(
   xMaxdt = new Number[NumUnknowns];
   Maxdt = 0.;
   InfPr = 42e6;
+
+  Aggregation   = NoAggregation;
+  NumStabConstr = NumEigVals;
+  AggrParam     = 0.;
+
+  WriteOutput = true;
+  Incumbent   = NULL;
+
+  ResultFormat       = "text";
+  CheckpointInterval = 0;
+  IterOffset         = 0;
+  CheckpointFile     = "./Checkpoint_Real_" + std::to_string(NumStages) + ".bin";
+  KeepBest           = false;
  }
 
  Roots_Real::Roots_Real(
@@ -109,7 +126,8 @@ Roots_Real::Roots_Real(
    const int NumStagesRef_,
    const Number dtRef_,
    const std::string EigValFileName,
-   const std::string HullPointPath
+   const std::string HullPointPath,
+   const Number DedupTol
 ) : NumStages(NumStages_), Degree(NumStages_), ConsOrder(ConsOrder_),
     NumStagesRef(NumStagesRef_), dtRef(dtRef_), dtExp((dtRef / NumStagesRef_) *  NumStages_)
 {
@@ -121,7 +139,7 @@ Roots_Real::Roots_Real(
   std::cout << "The expected maximal stable timestep is: " << dtExp  << std::endl << std::endl;
 
   NumEigVals = -1;
-  read_EigVals(EigValFileName, NumEigVals, RealEigValsScaled, ImagEigValsScaled);
+  read_EigVals(EigValFileName, NumEigVals, RealEigValsScaled, ImagEigValsScaled, DedupTol);
 
   for(size_t i = 0; i < NumEigVals; i++) {
     RealEigValsScaled[i] *= dtExp;
@@ -159,14 +177,11 @@ Roots_Real::Roots_Real(
   UseHull = true;
   std::cout << "Use hull for interpolation? " << UseHull << std::endl << std::endl;
 
-   std::string PE_HalfStagesFileName = "./RealImag_Optimized_" + std::to_string(NumStages/2) + ".txt";
-   if(std::filesystem::exists(PE_HalfStagesFileName)) {
+   std::vector<Number> Real_PE_HalfStagesScaled;
+   if(read_PE_Result(NumStages/2, NumStages/4, Real_PE_HalfStagesScaled)) {
       std::cout << "Use pseudo-extrema of " << std::to_string(NumStages/2) 
-               << " stage RKM for initialization, stored in file" 
-               << PE_HalfStagesFileName << std::endl << std::endl;
+                << " stage RKM for initialization" << std::endl << std::endl;
 
-      std::vector<Number> Real_PE_HalfStagesScaled;
-      read_PE(PE_HalfStagesFileName, NumStages/4, Real_PE_HalfStagesScaled);
       // Scale Pseudo-Extrema
       for(size_t i = 0; i < NumStages/4; i++)
          Real_PE_HalfStagesScaled[i] *= 2.0;
@@ -189,6 +204,134 @@ Roots_Real::Roots_Real(
   xMaxdt = new Number[NumUnknowns];
   Maxdt = 0.;
   InfPr = 42e6;
+
+  Aggregation   = NoAggregation;
+  NumStabConstr = NumEigVals;
+  AggrParam     = 0.;
+
+  WriteOutput = true;
+  Incumbent   = NULL;
+
+  ResultFormat       = "text";
+  CheckpointInterval = 0;
+  IterOffset         = 0;
+  CheckpointFile     = "./Checkpoint_Real_" + std::to_string(NumStages) + ".bin";
+  KeepBest           = false;
+}
+
+Roots_Real::Roots_Real(
+   const int NumStages_,
+   const int ConsOrder_,
+   const int NumStagesRef_,
+   const Number dtRef_,
+   const std::vector<Number>& RealEigVals,
+   const std::vector<Number>& ImagEigVals,
+   const std::vector<Number>& HullReal,
+   const std::vector<Number>& HullImag,
+   const std::vector<Number>& Real_PE_HalfStages
+) : NumStages(NumStages_), Degree(NumStages_), ConsOrder(ConsOrder_),
+    NumStagesRef(NumStagesRef_), dtRef(dtRef_), dtExp((dtRef / NumStagesRef_) *  NumStages_)
+{
+  std::cout << std::endl << "Optimize a " << Degree << " degree stability polynomial" << std::endl
+            << std::endl << "Optimize roots of the " << Degree - 1 << " \"lower\" degree polynomial" 
+            << std::endl << std::endl;
+
+  std::cout.precision(std::numeric_limits<Number>::max_digits10);
+  std::cout << "The expected maximal stable timestep is: " << dtExp  << std::endl << std::endl;
+
+  // CARE: Constraint points are assumed to be sorted with ascending real part (as done by 'read_EigVals')
+  assert(RealEigVals.size() == ImagEigVals.size());
+  NumEigVals = RealEigVals.size();
+  RealEigValsScaled = RealEigVals;
+  ImagEigValsScaled = ImagEigVals;
+
+  for(size_t i = 0; i < NumEigVals; i++) {
+    RealEigValsScaled[i] *= dtExp;
+    ImagEigValsScaled[i] *= dtExp;
+  }
+
+  RealUB  = std::min(RealEigValsScaled[NumEigVals-1], -1e-9); // Division by zero guard
+  RealMin = *min_element(std::begin(RealEigValsScaled), std::end(RealEigValsScaled));
+  // CARE: Assume that smallest real is @0, next @1
+  RealMargin = std::abs(RealMin - std::real(RealEigValsScaled[1]));
+
+  NumConstr = NumEigVals + ConsOrder - 1; // -1 Since one consistency order comes for free
+
+  OddDegree = Degree % 2;
+  NumRoots  = NumStages / 2; // Note: Integer division is here desired
+
+  // Optimize timestep now as well
+  NumUnknowns = NumRoots + 1;
+
+  assert(HullReal.size() == HullImag.size());
+  HullRealScaled = HullReal;
+  HullImagScaled = HullImag;
+
+  for(size_t i = 0; i < HullRealScaled.size(); i++) {
+      HullRealScaled[i] *= dtExp;
+      HullImagScaled[i] *= dtExp;
+  }
+
+  ImagDiff_over_RealDiff.resize(HullRealScaled.size() - 1);
+  for(size_t i = 0; i < HullRealScaled.size()-1; i++) {
+      ImagDiff_over_RealDiff[i] = (HullImagScaled[i+1] - HullImagScaled[i]) / 
+                                  (HullRealScaled[i+1] - HullRealScaled[i]);
+  }
+
+  UseHull = true;
+  std::cout << "Use hull for interpolation? " << UseHull << std::endl << std::endl;
+
+   std::vector<Number> Real_PE_HalfStagesScaled;
+   if(Real_PE_HalfStages.size() >= NumStages/4 && NumStages/4 > 0) {
+      std::cout << "Use pseudo-extrema of " << std::to_string(NumStages/2) 
+               << " stage RKM for initialization, supplied in memory" << std::endl << std::endl;
+
+      Real_PE_HalfStagesScaled.assign(Real_PE_HalfStages.begin(), Real_PE_HalfStages.begin() + NumStages/4);
+      // Scale Pseudo-Extrema
+      for(size_t i = 0; i < NumStages/4; i++)
+         Real_PE_HalfStagesScaled[i] *= 2.0;
+
+      x0 = InitialRootDistr(HullImagScaled.size(), NumUnknowns, NumStages, HullRealScaled, HullImagScaled, 
+                              NumStages/4, Real_PE_HalfStagesScaled);
+   }
+   else if(read_PE_Result(NumStages/2, NumStages/4, Real_PE_HalfStagesScaled)) {
+      std::cout << "Use pseudo-extrema of " << std::to_string(NumStages/2) 
+                << " stage RKM for initialization" << std::endl << std::endl;
+
+      // Scale Pseudo-Extrema
+      for(size_t i = 0; i < NumStages/4; i++)
+         Real_PE_HalfStagesScaled[i] *= 2.0;
+
+      x0 = InitialRootDistr(HullImagScaled.size(), NumUnknowns, NumStages, HullRealScaled, HullImagScaled, 
+                              NumStages/4, Real_PE_HalfStagesScaled);
+   }
+   else
+      x0 = InitialRootDistr(HullImagScaled.size(), NumUnknowns, NumStages, RealMin, HullRealScaled, HullImagScaled);
+
+   // Expect some slightly less optimal timestep
+   x0[NumRoots] = 0.95 * dtExp; 
+  
+  std::cout << "Initial values are: " << std::endl;
+  for(size_t i = 0; i < NumRoots; i++)
+    std::cout << x0[i] << std::endl;
+  std::cout << x0[NumRoots] << std::endl << std::endl;
+
+  xMaxdt = new Number[NumUnknowns];
+  Maxdt = 0.;
+  InfPr = 42e6;
+
+  Aggregation   = NoAggregation;
+  NumStabConstr = NumEigVals;
+  AggrParam     = 0.;
+
+  WriteOutput = true;
+  Incumbent   = NULL;
+
+  ResultFormat       = "text";
+  CheckpointInterval = 0;
+  IterOffset         = 0;
+  CheckpointFile     = "./Checkpoint_Real_" + std::to_string(NumStages) + ".bin";
+  KeepBest           = false;
 }
 
 // destructor
@@ -265,7 +408,7 @@ bool Roots_Real::get_bounds_info(
 
    x_u[NumRoots] = 1.1 * dtExp; // Allow for slightly larger timestep
 
-   for( Index i = 0; i < NumEigVals; i++ ) {
+   for( Index i = 0; i < NumStabConstr; i++ ) {
      // Not clear what is easier for the optimizer to handle
      //g_l[i] = 0.; // Automatically ensured by abs
      g_l[i] = -2e19; // Two times ipopt default value for treating number as inf
@@ -274,7 +417,7 @@ bool Roots_Real::get_bounds_info(
    }
 
    // Order constraints: Equality constraints
-   for ( Index i = NumEigVals; i < NumEigVals + ConsOrder - 1; i++ ) {
+   for ( Index i = NumStabConstr; i < NumConstr; i++ ) {
       g_l[i] = 0.;
       g_u[i] = 0.;
    }
@@ -312,9 +455,30 @@ bool Roots_Real::get_starting_point(
       x[i] = x0[i];
    }
 
+   // Reset best iterate (relevant for repeated optimizations, e.g. continuation), unless resumed
+   if(!KeepBest) {
+      for( Index i = 0; i < NumUnknowns; i++ )
+         xMaxdt[i] = x0[i];
+      Maxdt = 0.;
+      InfPr = 42e6;
+      // Multipliers of the best iterate: Those of the starting point
+      zLOpt     = (zL0.size() == NumUnknowns) ? zL0 : std::vector<Number>(NumUnknowns, 0.);
+      zUOpt     = (zU0.size() == NumUnknowns) ? zU0 : std::vector<Number>(NumUnknowns, 0.);
+      lambdaOpt = (lambda0.size() == NumConstr) ? lambda0 : std::vector<Number>(NumConstr, 0.);
+   }
+   KeepBest = false;
+   Budget.start();
+
+   // Multipliers are only requested for 'warm_start_init_point yes'
+   if(init_z)
+      for( Index i = 0; i < n; i++ ) {
+         z_L[i] = (zL0.size() == n) ? zL0[i] : 0.;
+         z_U[i] = (zU0.size() == n) ? zU0[i] : 0.;
+      }
+
    if(init_lambda)
       for( Index i = 0; i < m; i++ ) {
-         lambda[i] = 0.;
+         lambda[i] = (lambda0.size() == m) ? lambda0[i] : 0.;
       }
 
    return true;
@@ -358,6 +522,71 @@ bool Roots_Real::eval_grad_f(
 }
 // [TNLP_eval_grad_f]
 
+void Roots_Real::eval_StabConstr(
+   const Number* x,
+   Number*       gStab
+)
+{
+   if(OddDegree) {
+      if(UseHull)
+         StabConstr_Real(x, gStab, NumRoots, NumEigVals, RealEigValsScaled, ImagEigValsScaled, 
+                         HullRealScaled, HullImagScaled, dtExp);
+      else
+         StabConstr_Real(x, gStab, NumRoots, NumEigVals, RealEigValsScaled, ImagEigValsScaled, dtExp);
+   }
+   else {
+      i_min = 0;
+      for(size_t i = 1; i < NumRoots; i++) {
+         if(x[i] < x[i_min])
+            i_min = i;
+      }
+
+      if(UseHull)
+         StabConstr_Real(x, gStab, NumRoots, NumEigVals, RealEigValsScaled, ImagEigValsScaled, 
+                         HullRealScaled, HullImagScaled, ImagDiff_over_RealDiff, dtExp, i_min);
+      else
+         StabConstr_Real(x, gStab, NumRoots, NumEigVals, RealEigValsScaled, ImagEigValsScaled, ImagDiff_over_RealDiff, 
+                         dtExp, i_min);
+   }
+}
+
+template<typename T>
+T Roots_Real::StabConstr_i(
+   const std::vector<T>& x,
+   const size_t          i
+)
+{
+   if(OddDegree) {
+      if(UseHull)
+         return StabConstr_Real_i(x, NumRoots, RealEigValsScaled, ImagEigValsScaled, i, 
+                                  HullRealScaled, HullImagScaled, dtExp);
+      else
+         return StabConstr_Real_i(x, NumRoots, RealEigValsScaled, ImagEigValsScaled, i, dtExp);
+   }
+   else {
+      if(UseHull)
+         return StabConstr_Real_i(x, NumRoots, RealEigValsScaled, ImagEigValsScaled, i, 
+                                  HullRealScaled, HullImagScaled, ImagDiff_over_RealDiff, dtExp, i_min);
+      else
+         return StabConstr_Real_i(x, NumRoots, RealEigValsScaled, ImagEigValsScaled, i, 
+                                  ImagDiff_over_RealDiff, dtExp, i_min);
+   }
+}
+
+template<typename T>
+T Roots_Real::aggregate_StabConstr(
+   const T*     gStab,
+   const size_t Block
+) const
+{
+   const size_t i_begin = BlockBegin(Block,     NumStabConstr, NumEigVals);
+   const size_t i_end   = BlockBegin(Block + 1, NumStabConstr, NumEigVals);
+
+   // Passive maximum of the block as shift (prevents overflow for large aggregation parameters)
+   return Aggregate(Aggregation, gStab + i_begin, i_end - i_begin, AggrParam, 
+                    BlockShift(StabConstrValues.data() + i_begin, i_end - i_begin));
+}
+
 // [TNLP_eval_g]
 // return the value of the constraints: g(x)
 bool Roots_Real::eval_g(
@@ -374,65 +603,54 @@ bool Roots_Real::eval_g(
    assert(m == NumEigVals+ConsOrder-1);
    */
 
-   if(OddDegree) {
-      if(UseHull)
-         StabConstr_Real(x, g, NumRoots, NumEigVals, RealEigValsScaled, ImagEigValsScaled, 
-                         HullRealScaled, HullImagScaled, dtExp);
-      else
-         StabConstr_Real(x, g, NumRoots, NumEigVals, RealEigValsScaled, ImagEigValsScaled, dtExp);
+   if(Aggregation == NoAggregation)
+      eval_StabConstr(x, g); // Also determines 'i_min'
+   else {
+      eval_StabConstr(x, StabConstrValues.data());
+      for(size_t b = 0; b < NumStabConstr; b++)
+         g[b] = aggregate_StabConstr(StabConstrValues.data(), b);
+   }
 
+   if(OddDegree) {
       if(ConsOrder >= 2) {
          if(UseHull)
-            SecOrder(x, g, NumRoots, NumEigVals, HullRealScaled, HullImagScaled);
+            SecOrder(x, g, NumRoots, NumStabConstr, HullRealScaled, HullImagScaled);
          else
-            SecOrder(x, g, NumRoots, NumEigVals, RealEigValsScaled, ImagEigValsScaled);
+            SecOrder(x, g, NumRoots, NumStabConstr, RealEigValsScaled, ImagEigValsScaled);
 
          if(ConsOrder >= 3) {
             if(UseHull)
-               ThirdOrder(x, g, NumRoots, NumEigVals, HullRealScaled, HullImagScaled);
+               ThirdOrder(x, g, NumRoots, NumStabConstr, HullRealScaled, HullImagScaled);
             else
-               ThirdOrder(x, g, NumRoots, NumEigVals, RealEigValsScaled, ImagEigValsScaled);
+               ThirdOrder(x, g, NumRoots, NumStabConstr, RealEigValsScaled, ImagEigValsScaled);
 
             if(ConsOrder == 4){
                if(UseHull)
-                  FourthOrder(x, g, NumRoots, NumEigVals, HullRealScaled, HullImagScaled);
+                  FourthOrder(x, g, NumRoots, NumStabConstr, HullRealScaled, HullImagScaled);
                else
-                  FourthOrder(x, g, NumRoots, NumEigVals, RealEigValsScaled, ImagEigValsScaled);
+                  FourthOrder(x, g, NumRoots, NumStabConstr, RealEigValsScaled, ImagEigValsScaled);
             }
          }
       }
    }
    else {
-      i_min = 0;
-      for(size_t i = 1; i < NumRoots; i++) {
-         if(x[i] < x[i_min])
-            i_min = i;
-      }
-
-      if(UseHull)
-         StabConstr_Real(x, g, NumRoots, NumEigVals, RealEigValsScaled, ImagEigValsScaled, 
-                         HullRealScaled, HullImagScaled, ImagDiff_over_RealDiff, dtExp, i_min);
-      else
-         StabConstr_Real(x, g, NumRoots, NumEigVals, RealEigValsScaled, ImagEigValsScaled, ImagDiff_over_RealDiff, 
-                         dtExp, i_min);
-
       if(ConsOrder >= 2) {
          if(UseHull)
-            SecOrder(x, g, NumRoots, NumEigVals, HullRealScaled, HullImagScaled, ImagDiff_over_RealDiff, i_min);
+            SecOrder(x, g, NumRoots, NumStabConstr, HullRealScaled, HullImagScaled, ImagDiff_over_RealDiff, i_min);
          else
-            SecOrder(x, g, NumRoots, NumEigVals, RealEigValsScaled, ImagEigValsScaled, ImagDiff_over_RealDiff, i_min);
+            SecOrder(x, g, NumRoots, NumStabConstr, RealEigValsScaled, ImagEigValsScaled, ImagDiff_over_RealDiff, i_min);
 
          if(ConsOrder >= 3) {
             if(UseHull)
-               ThirdOrder(x, g, NumRoots, NumEigVals, HullRealScaled, HullImagScaled, ImagDiff_over_RealDiff, i_min);
+               ThirdOrder(x, g, NumRoots, NumStabConstr, HullRealScaled, HullImagScaled, ImagDiff_over_RealDiff, i_min);
             else
-               ThirdOrder(x, g, NumRoots, NumEigVals, RealEigValsScaled, ImagEigValsScaled, ImagDiff_over_RealDiff, i_min);
+               ThirdOrder(x, g, NumRoots, NumStabConstr, RealEigValsScaled, ImagEigValsScaled, ImagDiff_over_RealDiff, i_min);
 
             if(ConsOrder == 4) {
                if(UseHull)
-                  FourthOrder(x, g, NumRoots, NumEigVals, HullRealScaled, HullImagScaled, ImagDiff_over_RealDiff, i_min);
+                  FourthOrder(x, g, NumRoots, NumStabConstr, HullRealScaled, HullImagScaled, ImagDiff_over_RealDiff, i_min);
                else
-                  FourthOrder(x, g, NumRoots, NumEigVals, RealEigValsScaled, ImagEigValsScaled, ImagDiff_over_RealDiff, i_min);
+                  FourthOrder(x, g, NumRoots, NumStabConstr, RealEigValsScaled, ImagEigValsScaled, ImagDiff_over_RealDiff, i_min);
             }
          }
       }
@@ -491,13 +709,20 @@ bool Roots_Real::eval_jac_g(
       DCO_M::global_tape->register_variable(x_dco);
 
       std::vector<DCO_T> g(m);
-      
+      std::vector<DCO_T> gStabAggr; // Non-aggregated stability constraints in case of aggregation
+
+      if(Aggregation != NoAggregation) {
+         eval_StabConstr(x, StabConstrValues.data()); // Passive values for the shifts
+         gStabAggr.resize(NumEigVals);
+      }
+      std::vector<DCO_T>& gStab = (Aggregation == NoAggregation) ? g : gStabAggr;
+
       if(OddDegree) {
          if(UseHull)
-            StabConstr_Real(x_dco, g, NumRoots, NumEigVals, RealEigValsScaled, ImagEigValsScaled, 
+            StabConstr_Real(x_dco, gStab, NumRoots, NumEigVals, RealEigValsScaled, ImagEigValsScaled, 
                             HullRealScaled, HullImagScaled, dtExp);
          else
-            StabConstr_Real(x_dco, g, NumRoots, NumEigVals, RealEigValsScaled, ImagEigValsScaled, 
+            StabConstr_Real(x_dco, gStab, NumRoots, NumEigVals, RealEigValsScaled, ImagEigValsScaled, 
                             dtExp);
       }
       else {
@@ -508,17 +733,21 @@ bool Roots_Real::eval_jac_g(
          }
 
          if(UseHull)
-            StabConstr_Real(x_dco, g, NumRoots, NumEigVals, RealEigValsScaled, ImagEigValsScaled, 
+            StabConstr_Real(x_dco, gStab, NumRoots, NumEigVals, RealEigValsScaled, ImagEigValsScaled, 
                             HullRealScaled, HullImagScaled, ImagDiff_over_RealDiff, dtExp, i_min);
          else
-            StabConstr_Real(x_dco, g, NumRoots, NumEigVals, RealEigValsScaled, ImagEigValsScaled, 
+            StabConstr_Real(x_dco, gStab, NumRoots, NumEigVals, RealEigValsScaled, ImagEigValsScaled, 
                             ImagDiff_over_RealDiff, dtExp, i_min);
       }
 
+      if(Aggregation != NoAggregation)
+         for(size_t b = 0; b < NumStabConstr; b++)
+            g[b] = aggregate_StabConstr(gStabAggr.data(), b);
+
       DCO_M::global_tape->register_output_variable(g); // Record active output
 
       size_t ind = 0;
-      for(size_t i = 0; i < NumEigVals; i++) {
+      for(size_t i = 0; i < NumStabConstr; i++) {
          dco::derivative(g)[i] = 1.; // Seed component
 
          DCO_M::global_tape->interpret_adjoint(); // Interpret (stored) tape
@@ -537,20 +766,20 @@ bool Roots_Real::eval_jac_g(
       if(ConsOrder >= 2) {
          if(OddDegree) {
             if(UseHull)
-               SecOrder(x_dco, g, NumRoots, NumEigVals, HullRealScaled, HullImagScaled);
+               SecOrder(x_dco, g, NumRoots, NumStabConstr, HullRealScaled, HullImagScaled);
             else
-               SecOrder(x_dco, g, NumRoots, NumEigVals, RealEigValsScaled, ImagEigValsScaled);
+               SecOrder(x_dco, g, NumRoots, NumStabConstr, RealEigValsScaled, ImagEigValsScaled);
          }
          else {
             if(UseHull)
-               SecOrder(x_dco, g, NumRoots, NumEigVals, HullRealScaled, HullImagScaled, 
+               SecOrder(x_dco, g, NumRoots, NumStabConstr, HullRealScaled, HullImagScaled, 
                         ImagDiff_over_RealDiff, i_min);
             else
-               SecOrder(x_dco, g, NumRoots, NumEigVals, RealEigValsScaled, ImagEigValsScaled, 
+               SecOrder(x_dco, g, NumRoots, NumStabConstr, RealEigValsScaled, ImagEigValsScaled, 
                         ImagDiff_over_RealDiff, i_min);
          }
          
-         dco::derivative(g)[NumEigVals] = 1.; // Seed component
+         dco::derivative(g)[NumStabConstr] = 1.; // Seed component
 
          DCO_M::global_tape->interpret_adjoint(); // Interpret (stored) tape
 
@@ -565,20 +794,20 @@ bool Roots_Real::eval_jac_g(
 
             if(OddDegree) {
                if(UseHull)
-                  ThirdOrder(x_dco, g, NumRoots, NumEigVals, HullRealScaled, HullImagScaled);
+                  ThirdOrder(x_dco, g, NumRoots, NumStabConstr, HullRealScaled, HullImagScaled);
                else
-                  ThirdOrder(x_dco, g, NumRoots, NumEigVals, RealEigValsScaled, ImagEigValsScaled);
+                  ThirdOrder(x_dco, g, NumRoots, NumStabConstr, RealEigValsScaled, ImagEigValsScaled);
             }
             else {
                if(UseHull)
-                  ThirdOrder(x_dco, g, NumRoots, NumEigVals, HullRealScaled, HullImagScaled, 
+                  ThirdOrder(x_dco, g, NumRoots, NumStabConstr, HullRealScaled, HullImagScaled, 
                            ImagDiff_over_RealDiff, i_min);
                else
-                  ThirdOrder(x_dco, g, NumRoots, NumEigVals, RealEigValsScaled, ImagEigValsScaled, 
+                  ThirdOrder(x_dco, g, NumRoots, NumStabConstr, RealEigValsScaled, ImagEigValsScaled, 
                            ImagDiff_over_RealDiff, i_min);
             }
             
-            dco::derivative(g)[NumEigVals + 1] = 1.; // Seed component
+            dco::derivative(g)[NumStabConstr + 1] = 1.; // Seed component
 
             DCO_M::global_tape->interpret_adjoint(); // Interpret (stored) tape
 
@@ -593,21 +822,21 @@ bool Roots_Real::eval_jac_g(
 
                if(OddDegree) {
                   if(UseHull)
-                     FourthOrder(x_dco, g, NumRoots, NumEigVals, HullRealScaled, HullImagScaled);
+                     FourthOrder(x_dco, g, NumRoots, NumStabConstr, HullRealScaled, HullImagScaled);
                   else
-                     FourthOrder(x_dco, g, NumRoots, NumEigVals, RealEigValsScaled, ImagEigValsScaled);
+                     FourthOrder(x_dco, g, NumRoots, NumStabConstr, RealEigValsScaled, ImagEigValsScaled);
                }
                else {
                   if(UseHull)
-                     FourthOrder(x_dco, g, NumRoots, NumEigVals, HullRealScaled, HullImagScaled, 
+                     FourthOrder(x_dco, g, NumRoots, NumStabConstr, HullRealScaled, HullImagScaled, 
                                  ImagDiff_over_RealDiff, i_min);
                   else
-                     FourthOrder(x_dco, g, NumRoots, NumEigVals, RealEigValsScaled, ImagEigValsScaled, 
+                     FourthOrder(x_dco, g, NumRoots, NumStabConstr, RealEigValsScaled, ImagEigValsScaled, 
                                  ImagDiff_over_RealDiff, i_min);
                
                }
 
-               dco::derivative(g)[NumEigVals + 2] = 1.; // Seed component
+               dco::derivative(g)[NumStabConstr + 2] = 1.; // Seed component
 
                DCO_M::global_tape->interpret_adjoint(); // Interpret (stored) tape
 
@@ -675,7 +904,6 @@ bool Roots_Real::eval_h(
 
       // Constraints
 
-      /// First Eigenvalue ///
       using DCO_BM  = typename dco::ga1s<Number>; // adjoint (base) mode
       using DCO_BT  = typename DCO_BM::type; // adjoint (base) type
       using DCO_BTT = typename DCO_BM::tape_t; // base tape type
@@ -689,106 +917,161 @@ bool Roots_Real::eval_h(
       DCO_M::global_tape  = DCO_TT::create(); // "touch" tape
 
       DCO_T g; // Scalar output
-
-      for (size_t i = 0; i < NumUnknowns; i++) {
-         DCO_BM::global_tape->register_variable(dco::value(x_dco[i]) ); // record active input
-         DCO_BM::global_tape->register_variable(dco::derivative(x_dco[i]) ); // record active input
-
-         dco::value(dco::value(x_dco[i]) ) = x[i];
-
-         DCO_M::global_tape->register_variable(x_dco[i]);
-      }
-      
-      if(OddDegree) {
-         if(UseHull)
-            g = StabConstr_Real_i(x_dco, NumRoots, RealEigValsScaled, ImagEigValsScaled, 0, 
-                                  HullRealScaled, HullImagScaled, dtExp);
-         else
-            g = StabConstr_Real_i(x_dco, NumRoots, RealEigValsScaled, ImagEigValsScaled, 0, dtExp);
-      }
-      else {
-         i_min = 0;
-         for(size_t i = 1; i < NumRoots; i++) {
-            if(x[i] < x[i_min])
-               i_min = i;
-         }
-         if(UseHull)
-            g = StabConstr_Real_i(x_dco, NumRoots, RealEigValsScaled, ImagEigValsScaled, 0, 
-                                  HullRealScaled, HullImagScaled, ImagDiff_over_RealDiff, dtExp, i_min);
-         else
-            g = StabConstr_Real_i(x_dco, NumRoots, RealEigValsScaled, ImagEigValsScaled, 0, 
-                                  ImagDiff_over_RealDiff, dtExp, i_min);
-      }
-
-      dco::value(dco::derivative(g) ) = 1.; // Seed
-      DCO_M::global_tape->interpret_adjoint(); // Back-propagate from output/adjoint
-
       int ind = 0;
-      for(size_t i = 0; i < NumUnknowns; i++) {
-         dco::derivative(dco::derivative(x_dco[i]) ) = 1.; // Seed
 
-         DCO_BM::global_tape->interpret_adjoint(); // Back-propagate from output/adjoint
-         for(size_t j = 0; j <= i; j++) { // Fill lower left triangle only
-            values[ind] = lambda[0] * dco::derivative(dco::value(x_dco[j]) );
-            ind++;
-         }
-
-         //dco::derivative(dco::derivative(x_dco[i]) ) = 0.; // Unseed
-
-         DCO_BM::global_tape->zero_adjoints();
-      }
-
-      // Clear tape only, do not remove
-      DCO_M::global_tape->reset();
-      DCO_BM::global_tape->reset();
-
-      /// Remaining Eigenvalues ///
-      for(size_t i = 1; i < NumEigVals; i++) {
-         for (size_t j = 0; j < NumUnknowns; j++) {
-            DCO_BM::global_tape->register_variable(dco::value(x_dco[j]) ); // record active input
-            DCO_BM::global_tape->register_variable(dco::derivative(x_dco[j]) ); // record active input
+      if(Aggregation == NoAggregation) {
+         /// First Eigenvalue ///
+         for (size_t i = 0; i < NumUnknowns; i++) {
+            DCO_BM::global_tape->register_variable(dco::value(x_dco[i]) ); // record active input
+            DCO_BM::global_tape->register_variable(dco::derivative(x_dco[i]) ); // record active input
 
-            dco::value(dco::value(x_dco[j]) ) = x[j];
+            dco::value(dco::value(x_dco[i]) ) = x[i];
 
-            DCO_M::global_tape->register_variable(x_dco[j]);
+            DCO_M::global_tape->register_variable(x_dco[i]);
          }
-
+      
          if(OddDegree) {
             if(UseHull)
-               g = StabConstr_Real_i(x_dco, NumRoots, RealEigValsScaled, ImagEigValsScaled, i, 
+               g = StabConstr_Real_i(x_dco, NumRoots, RealEigValsScaled, ImagEigValsScaled, 0, 
                                      HullRealScaled, HullImagScaled, dtExp);
             else
-               g = StabConstr_Real_i(x_dco, NumRoots, RealEigValsScaled, ImagEigValsScaled, i, dtExp);
+               g = StabConstr_Real_i(x_dco, NumRoots, RealEigValsScaled, ImagEigValsScaled, 0, dtExp);
          }
          else {
+            i_min = 0;
+            for(size_t i = 1; i < NumRoots; i++) {
+               if(x[i] < x[i_min])
+                  i_min = i;
+            }
             if(UseHull)
-               g = StabConstr_Real_i(x_dco, NumRoots, RealEigValsScaled, ImagEigValsScaled, i, 
+               g = StabConstr_Real_i(x_dco, NumRoots, RealEigValsScaled, ImagEigValsScaled, 0, 
                                      HullRealScaled, HullImagScaled, ImagDiff_over_RealDiff, dtExp, i_min);
             else
-               g = StabConstr_Real_i(x_dco, NumRoots, RealEigValsScaled, ImagEigValsScaled, i, 
-                                    ImagDiff_over_RealDiff, dtExp, i_min);
-         }           
+               g = StabConstr_Real_i(x_dco, NumRoots, RealEigValsScaled, ImagEigValsScaled, 0, 
+                                     ImagDiff_over_RealDiff, dtExp, i_min);
+         }
 
          dco::value(dco::derivative(g) ) = 1.; // Seed
          DCO_M::global_tape->interpret_adjoint(); // Back-propagate from output/adjoint
 
          ind = 0;
-         for(size_t k = 0; k < NumUnknowns; k++) {
-            dco::derivative(dco::derivative(x_dco[k]) ) = 1.; // Seed
+         for(size_t i = 0; i < NumUnknowns; i++) {
+            dco::derivative(dco::derivative(x_dco[i]) ) = 1.; // Seed
 
             DCO_BM::global_tape->interpret_adjoint(); // Back-propagate from output/adjoint
-            for(size_t j = 0; j <= k; j++) {
-               values[ind] += lambda[i] * dco::derivative(dco::value(x_dco[j]) );
+            for(size_t j = 0; j <= i; j++) { // Fill lower left triangle only
+               values[ind] = lambda[0] * dco::derivative(dco::value(x_dco[j]) );
                ind++;
             }
 
-            //dco::derivative(dco::derivative(x_dco[k]) ) = 0.; // Unseed
+            //dco::derivative(dco::derivative(x_dco[i]) ) = 0.; // Unseed
+
             DCO_BM::global_tape->zero_adjoints();
          }
 
          // Clear tape only, do not remove
          DCO_M::global_tape->reset();
          DCO_BM::global_tape->reset();
+
+         /// Remaining Eigenvalues ///
+         for(size_t i = 1; i < NumEigVals; i++) {
+            for (size_t j = 0; j < NumUnknowns; j++) {
+               DCO_BM::global_tape->register_variable(dco::value(x_dco[j]) ); // record active input
+               DCO_BM::global_tape->register_variable(dco::derivative(x_dco[j]) ); // record active input
+
+               dco::value(dco::value(x_dco[j]) ) = x[j];
+
+               DCO_M::global_tape->register_variable(x_dco[j]);
+            }
+
+            if(OddDegree) {
+               if(UseHull)
+                  g = StabConstr_Real_i(x_dco, NumRoots, RealEigValsScaled, ImagEigValsScaled, i, 
+                                        HullRealScaled, HullImagScaled, dtExp);
+               else
+                  g = StabConstr_Real_i(x_dco, NumRoots, RealEigValsScaled, ImagEigValsScaled, i, dtExp);
+            }
+            else {
+               if(UseHull)
+                  g = StabConstr_Real_i(x_dco, NumRoots, RealEigValsScaled, ImagEigValsScaled, i, 
+                                        HullRealScaled, HullImagScaled, ImagDiff_over_RealDiff, dtExp, i_min);
+               else
+                  g = StabConstr_Real_i(x_dco, NumRoots, RealEigValsScaled, ImagEigValsScaled, i, 
+                                       ImagDiff_over_RealDiff, dtExp, i_min);
+            }           
+
+            dco::value(dco::derivative(g) ) = 1.; // Seed
+            DCO_M::global_tape->interpret_adjoint(); // Back-propagate from output/adjoint
+
+            ind = 0;
+            for(size_t k = 0; k < NumUnknowns; k++) {
+               dco::derivative(dco::derivative(x_dco[k]) ) = 1.; // Seed
+
+               DCO_BM::global_tape->interpret_adjoint(); // Back-propagate from output/adjoint
+               for(size_t j = 0; j <= k; j++) {
+                  values[ind] += lambda[i] * dco::derivative(dco::value(x_dco[j]) );
+                  ind++;
+               }
+
+               //dco::derivative(dco::derivative(x_dco[k]) ) = 0.; // Unseed
+               DCO_BM::global_tape->zero_adjoints();
+            }
+
+            // Clear tape only, do not remove
+            DCO_M::global_tape->reset();
+            DCO_BM::global_tape->reset();
+         }
+      }
+      else {
+         /// Aggregated blocks of eigenvalues ///
+         eval_StabConstr(x, StabConstrValues.data()); // Passive values for the shifts, also 'i_min'
+
+         for(ind = 0; ind < nele_hess; ind++)
+            values[ind] = 0.;
+
+         std::vector<DCO_T> gStab; // Non-negligible constraints of the block
+         gStab.reserve(NumEigVals);
+         for(size_t b = 0; b < NumStabConstr; b++) {
+            const size_t i_begin = BlockBegin(b,     NumStabConstr, NumEigVals);
+            const size_t i_end   = BlockBegin(b + 1, NumStabConstr, NumEigVals);
+            const Number Shift   = BlockShift(StabConstrValues.data() + i_begin, i_end - i_begin);
+
+            for (size_t j = 0; j < NumUnknowns; j++) {
+               DCO_BM::global_tape->register_variable(dco::value(x_dco[j]) ); // record active input
+               DCO_BM::global_tape->register_variable(dco::derivative(x_dco[j]) ); // record active input
+
+               dco::value(dco::value(x_dco[j]) ) = x[j];
+
+               DCO_M::global_tape->register_variable(x_dco[j]);
+            }
+
+            // Tape only eigenvalues that contribute to the Hessian of the aggregate
+            gStab.clear();
+            for(size_t i = i_begin; i < i_end; i++)
+               if(!HessianNegligible(Aggregation, StabConstrValues[i], AggrParam, Shift))
+                  gStab.push_back(StabConstr_i(x_dco, i));
+            g = Aggregate(Aggregation, gStab.data(), gStab.size(), AggrParam, Shift);
+
+            dco::value(dco::derivative(g) ) = 1.; // Seed
+            DCO_M::global_tape->interpret_adjoint(); // Back-propagate from output/adjoint
+
+            ind = 0;
+            for(size_t k = 0; k < NumUnknowns; k++) {
+               dco::derivative(dco::derivative(x_dco[k]) ) = 1.; // Seed
+
+               DCO_BM::global_tape->interpret_adjoint(); // Back-propagate from output/adjoint
+               for(size_t j = 0; j <= k; j++) {
+                  values[ind] += lambda[b] * dco::derivative(dco::value(x_dco[j]) );
+                  ind++;
+               }
+
+               DCO_BM::global_tape->zero_adjoints(); // Unseed
+            }
+
+            // Clear tape only, do not remove
+            DCO_M::global_tape->reset();
+            DCO_BM::global_tape->reset();
+         }
       }
 
       /// Order constraints ///
@@ -825,7 +1108,7 @@ bool Roots_Real::eval_h(
 
             DCO_BM::global_tape->interpret_adjoint(); // Back-propagate from output/adjoint
             for(size_t j = 0; j <= k; j++) {
-               values[ind] += lambda[NumEigVals] * dco::derivative(dco::value(x_dco[j]) );
+               values[ind] += lambda[NumStabConstr] * dco::derivative(dco::value(x_dco[j]) );
                ind++;
             }
 
@@ -864,7 +1147,7 @@ bool Roots_Real::eval_h(
 
                DCO_BM::global_tape->interpret_adjoint(); // Back-propagate from output/adjoint
                for(size_t j = 0; j <= k; j++) {
-                  values[ind] += lambda[NumEigVals + 1] * dco::derivative(dco::value(x_dco[j]) );
+                  values[ind] += lambda[NumStabConstr + 1] * dco::derivative(dco::value(x_dco[j]) );
                   ind++;
                }
 
@@ -903,7 +1186,7 @@ bool Roots_Real::eval_h(
 
                   DCO_BM::global_tape->interpret_adjoint(); // Back-propagate from output/adjoint
                   for(size_t j = 0; j <= k; j++) {
-                     values[ind] += lambda[NumEigVals + 2] * dco::derivative(dco::value(x_dco[j]) );
+                     values[ind] += lambda[NumStabConstr + 2] * dco::derivative(dco::value(x_dco[j]) );
                      ind++;
                   }
 
@@ -948,20 +1231,39 @@ bool Roots_Real::intermediate_callback(
          if(obj_value < Maxdt) {
             Maxdt = obj_value;
             InfPr = ip_cq->unscaled_curr_nlp_constraint_violation(NORM_MAX);
-            get_curr_iterate(ip_data, ip_cq, false, NumUnknowns, xMaxdt, NULL, NULL, NumConstr, NULL, NULL);
+            get_curr_iterate(ip_data, ip_cq, false, NumUnknowns, xMaxdt, zLOpt.data(), zUOpt.data(), 
+                             NumConstr, NULL, lambdaOpt.data());
          }
       }
       else { // Case where current is significantly better then current best
          if(ip_cq->unscaled_curr_nlp_constraint_violation(NORM_MAX) < InfPr) {
             InfPr = ip_cq->unscaled_curr_nlp_constraint_violation(NORM_MAX);
-            get_curr_iterate(ip_data, ip_cq, false, NumUnknowns, xMaxdt, NULL, NULL, NumConstr, NULL, NULL);
+            get_curr_iterate(ip_data, ip_cq, false, NumUnknowns, xMaxdt, zLOpt.data(), zUOpt.data(), 
+                             NumConstr, NULL, lambdaOpt.data());
             // In that case: Always update timestep
             Maxdt = obj_value;
          }
       }
    }
 
-   return true;
+   if(Incumbent != NULL && mode == RegularMode) {
+      const Number dt = -obj_value;
+      if(ip_cq->unscaled_curr_nlp_constraint_violation(NORM_MAX) <= FeasTol) {
+         Number BestDt = Incumbent->load();
+         while(dt > BestDt && !Incumbent->compare_exchange_weak(BestDt, dt));
+      }
+
+      // Current start is unlikely to beat the incumbent
+      if(iter >= AbortIter && dt < (1. - AbortMargin) * Incumbent->load()) {
+         std::cout << "Abort: Timestep " << dt << " lags behind incumbent " << Incumbent->load() << std::endl;
+         return false;
+      }
+   }
+
+   if(CheckpointInterval > 0 && mode == RegularMode && iter > 0 && iter % CheckpointInterval == 0)
+      write_checkpoint(iter, mu, ip_data, ip_cq);
+
+   return Budget.check(iter, -Maxdt, InfPr);
 }
 // [TNLP_intermediate_callback]
 
@@ -1023,7 +1325,83 @@ void Roots_Real::finalize_solution(
    }
    */
 
-   Number Constr[NumConstr];
+   Number Constr[NumEigVals + ConsOrder - 1]; // Always the exact (non-aggregated) constraints
+   eval_exact_constraints(Constr);
+
+   if(WriteOutput)
+      write_output(Constr);
+
+   // Converged: Checkpoint is obsolete
+   if(status == SUCCESS && CheckpointInterval > 0)
+      std::remove(CheckpointFile.c_str());
+
+   if(!WarmStartFile.empty())
+      write_WarmStart(WarmStartFile, get_solution(), zLOpt, zUOpt, lambdaOpt);
+}
+// [TNLP_finalize_solution]
+
+void Roots_Real::write_solution_files()
+{
+   const Index n = NumUnknowns;
+   if(!OddDegree) {
+      i_min = 0;
+      for(size_t i = 1; i < NumRoots; i++) {
+         if(xMaxdt[i] < xMaxdt[i_min])
+            i_min = i;
+      }
+   }
+
+   std::ofstream RealOptFile("./Real_Optimized_" + std::to_string(NumStages) + ".txt");
+   for(size_t i = 0; i < n; i++) {
+      std::stringstream StringStr; // On purpose within loop (automatic reset)
+      StringStr << std::setprecision(std::numeric_limits<Number>::max_digits10);
+      StringStr << xMaxdt[i];
+      RealOptFile << StringStr.str();
+      if(i != n-1)
+         RealOptFile << "\n";
+   }
+   RealOptFile.close();
+
+   // TODO: Write out with special treatment for min_real
+   const std::string PE_FileName = "./PE_" + std::to_string(NumStages);
+   std::ofstream PseudoExtremaFile(PE_FileName + ".txt");
+
+   std::stringstream StringStr;
+   StringStr << std::setprecision(std::numeric_limits<Number>::max_digits10);
+   StringStr << xMaxdt[i_min];
+   PseudoExtremaFile << StringStr.str();
+   PseudoExtremaFile << "\n";
+   for(size_t i = 0; i < i_min; i++) {
+      std::stringstream StringStr; // On purpose within loop (automatic reset)
+      StringStr << std::setprecision(std::numeric_limits<Number>::max_digits10);
+      StringStr << xMaxdt[i] << "+";
+      if(UseHull)
+         StringStr << Lin_IntPol(xMaxdt[i], HullRealScaled, HullImagScaled) << "i";
+      else
+         StringStr << Lin_IntPol(xMaxdt[i], RealEigValsScaled, ImagEigValsScaled) << "i";
+      PseudoExtremaFile << StringStr.str();
+      if(i != n-2)
+         PseudoExtremaFile << "\n";
+   }
+   for(size_t i = i_min + 1; i < n-1; i++) {
+      std::stringstream StringStr; // On purpose within loop (automatic reset)
+      StringStr << std::setprecision(std::numeric_limits<Number>::max_digits10);
+      StringStr << xMaxdt[i] << "+";
+      if(UseHull)
+         StringStr << Lin_IntPol(xMaxdt[i], HullRealScaled, HullImagScaled) << "i";
+      else
+         StringStr << Lin_IntPol(xMaxdt[i], RealEigValsScaled, ImagEigValsScaled) << "i";
+      PseudoExtremaFile << StringStr.str();
+      if(i != n-2)
+         PseudoExtremaFile << "\n";
+   }
+   PseudoExtremaFile.close();
+}
+
+void Roots_Real::eval_exact_constraints(
+   Number* Constr
+)
+{
    if(OddDegree)
       if(UseHull)
          StabConstr_Real(xMaxdt, Constr, NumRoots, NumEigVals, RealEigValsScaled, ImagEigValsScaled, 
@@ -1104,53 +1482,335 @@ void Roots_Real::finalize_solution(
          }
       }
    }
+}
 
-   /// Write to file section ///
+void Roots_Real::write_output(
+   const Number* Constr
+)
+{
+   if(ResultFormat != "bundle")
+      write_solution_files();
+   if(ResultFormat != "text")
+      write_result_bundle(Constr);
+}
 
-   std::ofstream RealOptFile("./Real_Optimized_" + std::to_string(NumStages) + ".txt");
-   for(size_t i = 0; i < n; i++) {
-      std::stringstream StringStr; // On purpose within loop (automatic reset)
-      StringStr << std::setprecision(std::numeric_limits<Number>::max_digits10);
-      StringStr << xMaxdt[i];
-      RealOptFile << StringStr.str();
-      if(i != n-1)
-         RealOptFile << "\n";
+void Roots_Real::write_results()
+{
+   std::vector<Number> Constr(NumEigVals + ConsOrder - 1);
+   eval_exact_constraints(Constr.data());
+   write_output(Constr.data());
+}
+
+void Roots_Real::write_result_bundle(
+   const Number* Constr
+)
+{
+   ResultBundle Bundle("Real", NumStages, ConsOrder);
+   Bundle.add("x", xMaxdt, NumUnknowns);
+
+   // Interpolated imaginary parts of the roots (as in 'PE_S.txt')
+   std::vector<Number> RootsImag(NumRoots);
+   for(size_t i = 0; i < NumRoots; i++)
+      RootsImag[i] = UseHull ? Lin_IntPol(xMaxdt[i], HullRealScaled, HullImagScaled) : 
+                               Lin_IntPol(xMaxdt[i], RealEigValsScaled, ImagEigValsScaled);
+   Bundle.add("roots_imag", RootsImag);
+
+   Bundle.add("constraints", Constr, NumEigVals + ConsOrder - 1);
+   Bundle.add("z_L", zLOpt);
+   Bundle.add("z_U", zUOpt);
+   Bundle.add("lambda", lambdaOpt);
+
+   if(!Bundle.write(xMaxdt[NumRoots]))
+      std::cout << "CARE: Could not write result bundle " << ResultBundlePrefix("Real", NumStages) << std::endl;
+}
+
+void Roots_Real::set_result_format(
+   const std::string Format
+)
+{
+   assert(Format == "text" || Format == "bundle" || Format == "both");
+   ResultFormat = Format;
+}
+
+void Roots_Real::set_initial_point(
+   const std::vector<Number>& x0_
+)
+{
+   assert(x0_.size() == NumUnknowns);
+   x0 = x0_;
+
+   std::cout << "Initial values are: " << std::endl;
+   for(size_t i = 0; i < NumRoots; i++)
+     std::cout << x0[i] << std::endl;
+   std::cout << x0[NumRoots] << std::endl << std::endl;
+}
+
+void Roots_Real::set_warm_start(
+   const std::vector<Number>& x0_,
+   const std::vector<Number>& zL0_,
+   const std::vector<Number>& zU0_,
+   const std::vector<Number>& lambda0_
+)
+{
+   set_initial_point(x0_);
+   zL0     = zL0_;
+   zU0     = zU0_;
+   lambda0 = lambda0_;
+}
+
+bool Roots_Real::enable_warm_start_persistence()
+{
+   WarmStartFile = WarmStartFileName("Real", NumStages, ConsOrder, NumStagesRef, dtRef, 
+                                     RealEigValsScaled, ImagEigValsScaled, HullRealScaled, HullImagScaled);
+
+   std::vector<Number> x, zL, zU, lambda;
+   if(!read_WarmStart(WarmStartFile, x, zL, zU, lambda) || x.size() != NumUnknowns)
+      return false;
+
+   std::cout << "Warmstart from " << WarmStartFile << std::endl;
+   // Multipliers of a different number of constraints (e.g. changed aggregation) are not reused
+   if(lambda.size() != NumConstr)
+      lambda.clear();
+   set_warm_start(x, zL, zU, lambda);
+
+   return true;
+}
+
+bool Roots_Real::init_from_database(
+   const std::string DataBaseDir,
+   const Number      MaxDist
+)
+{
+   const std::vector<Number>& CurveReal = UseHull ? HullRealScaled : RealEigValsScaled;
+   const std::vector<Number>& CurveImag = UseHull ? HullImagScaled : ImagEigValsScaled;
+
+   const std::vector<WarmStartRecord> Records = read_WarmStartDB(WarmStartDBFileName(DataBaseDir, ConsOrder));
+   const std::vector<double> Shape = CurveShape(CurveReal, CurveImag);
+
+   Number MinDist = std::numeric_limits<Number>::max();
+   size_t Nearest = 0;
+   for(size_t i = 0; i < Records.size(); i++) {
+      const Number Dist = RecordDistance(Records[i], NumStages, Shape);
+      if(Dist < MinDist) {
+         MinDist = Dist;
+         Nearest = i;
+      }
    }
-   RealOptFile.close();
+   if(MinDist > MaxDist)
+      return false;
 
-   // TODO: Write out with special treatment for min_real
-   const std::string PE_FileName = "./PE_" + std::to_string(NumStages);
-   std::ofstream PseudoExtremaFile(PE_FileName + ".txt");
+   std::cout << "Initialize from database record with S = " << Records[Nearest].NumStages 
+             << " (distance " << MinDist << ")" << std::endl;
 
-   std::stringstream StringStr;
-   StringStr << std::setprecision(std::numeric_limits<Number>::max_digits10);
-   StringStr << xMaxdt[i_min];
-   PseudoExtremaFile << StringStr.str();
-   PseudoExtremaFile << "\n";
-   for(size_t i = 0; i < i_min; i++) {
-      std::stringstream StringStr; // On purpose within loop (automatic reset)
-      StringStr << std::setprecision(std::numeric_limits<Number>::max_digits10);
-      StringStr << xMaxdt[i] << "+";
+   std::vector<Number> x = MapRootFractions(Records[Nearest].RootFractions, NumRoots, CurveReal, CurveImag);
+   x.push_back(Records[Nearest].dtRatio * dtExp);
+   set_initial_point(x);
+
+   return true;
+}
+
+void Roots_Real::store_in_database(
+   const std::string DataBaseDir
+) const
+{
+   const std::vector<Number>& CurveReal = UseHull ? HullRealScaled : RealEigValsScaled;
+   const std::vector<Number>& CurveImag = UseHull ? HullImagScaled : ImagEigValsScaled;
+
+   WarmStartRecord Record;
+   Record.NumStages     = NumStages;
+   Record.dtRatio       = xMaxdt[NumRoots] / dtExp;
+   Record.Shape         = CurveShape(CurveReal, CurveImag);
+   Record.RootFractions = RootFractions(std::vector<Number>(xMaxdt, xMaxdt + NumRoots), CurveReal, CurveImag);
+
+   std::filesystem::create_directories(DataBaseDir);
+   append_WarmStartDB(WarmStartDBFileName(DataBaseDir, ConsOrder), Record);
+}
+
+void Roots_Real::get_duals(
+   std::vector<Number>& zL,
+   std::vector<Number>& zU,
+   std::vector<Number>& lambda
+) const
+{
+   zL     = zLOpt;
+   zU     = zUOpt;
+   lambda = lambdaOpt;
+}
+
+void Roots_Real::set_solution(
+   const std::vector<Number>& x
+)
+{
+   assert(x.size() == NumUnknowns);
+   for(size_t i = 0; i < NumUnknowns; i++)
+      xMaxdt[i] = x[i];
+}
+
+void Roots_Real::set_incumbent(
+   std::atomic<Number>* Incumbent_,
+   const Number         AbortMargin_,
+   const Number         FeasTol_,
+   const Index          AbortIter_
+)
+{
+   Incumbent   = Incumbent_;
+   AbortMargin = AbortMargin_;
+   FeasTol     = FeasTol_;
+   AbortIter   = AbortIter_;
+}
+
+void Roots_Real::set_checkpointing(
+   const Index Interval
+)
+{
+   CheckpointInterval = Interval;
+}
+
+void Roots_Real::write_checkpoint(
+   const Index                iter,
+   const Number               mu,
+   const IpoptData*           ip_data,
+   IpoptCalculatedQuantities* ip_cq
+)
+{
+   Checkpoint State;
+   State.Signature = ProblemSignature("Real", NumStages, ConsOrder, NumStagesRef, dtRef, 
+                                      RealEigValsScaled, ImagEigValsScaled, HullRealScaled, HullImagScaled);
+   State.Iter = IterOffset + iter;
+   State.mu   = mu;
+   State.x.resize(NumUnknowns);
+   State.zL.resize(NumUnknowns);
+   State.zU.resize(NumUnknowns);
+   State.lambda.resize(NumConstr);
+   get_curr_iterate(ip_data, ip_cq, false, NumUnknowns, State.x.data(), State.zL.data(), State.zU.data(), 
+                    NumConstr, NULL, State.lambda.data());
+
+   State.xBest.assign(xMaxdt, xMaxdt + NumUnknowns);
+   State.zLBest     = zLOpt;
+   State.zUBest     = zUOpt;
+   State.lambdaBest = lambdaOpt;
+   State.BestObj    = Maxdt;
+   State.BestInfPr  = InfPr;
+
+   if(!write_Checkpoint(CheckpointFile, State))
+      std::cout << "CARE: Could not write checkpoint " << CheckpointFile << std::endl;
+}
+
+Index Roots_Real::resume_from_checkpoint(
+   Number& mu
+)
+{
+   Checkpoint State;
+   if(!read_Checkpoint(CheckpointFile, State, NumUnknowns, NumEigVals + ConsOrder - 1)) {
+      std::cout << "No (valid) checkpoint " << CheckpointFile << " found, start from scratch" << std::endl;
+      return -1;
+   }
+   if(State.Signature != ProblemSignature("Real", NumStages, ConsOrder, NumStagesRef, dtRef, 
+                                          RealEigValsScaled, ImagEigValsScaled, HullRealScaled, HullImagScaled)) {
+      std::cout << "CARE: Checkpoint " << CheckpointFile << " belongs to a different problem, start from scratch" 
+                << std::endl;
+      return -1;
+   }
+   std::cout << "Resume from " << CheckpointFile << " at iteration " << State.Iter 
+             << " with mu = " << State.mu << std::endl;
+   mu = State.mu;
+
+   // Multipliers of a different number of constraints (e.g. aggregated) are not reused
+   if(State.lambda.size() != NumConstr)
+      State.lambda.clear();
+   set_warm_start(State.x, State.zL, State.zU, State.lambda);
+
+   for(size_t i = 0; i < NumUnknowns; i++)
+      xMaxdt[i] = State.xBest[i];
+   Maxdt = State.BestObj;
+   InfPr = State.BestInfPr;
+   zLOpt     = State.zLBest;
+   zUOpt     = State.zUBest;
+   lambdaOpt = (State.lambdaBest.size() == NumConstr) ? State.lambdaBest : std::vector<Number>(NumConstr, 0.);
+
+   KeepBest   = true;
+   IterOffset = State.Iter;
+
+   return State.Iter;
+}
+
+void Roots_Real::set_budget(
+   const Number TimeBudget,
+   const Index  StagnationIter,
+   const Number StagnationTol,
+   const Number StagnationFeasTol
+)
+{
+   Budget.TimeBudget        = TimeBudget;
+   Budget.StagnationIter    = StagnationIter;
+   Budget.StagnationTol     = StagnationTol;
+   Budget.StagnationFeasTol = StagnationFeasTol;
+   Budget.start_run();
+}
+
+std::vector<Number> Roots_Real::get_solution() const
+{
+   return std::vector<Number>(xMaxdt, xMaxdt + NumUnknowns);
+}
+
+Number Roots_Real::eval_AbsStabPnom(
+   const Number RealEV,
+   const Number ImagEV
+) const
+{
+   // Constraint functions expect scaled eigenvalues
+   const std::vector<Number> RealEV_Scaled{RealEV * dtExp};
+   const std::vector<Number> ImagEV_Scaled{ImagEV * dtExp};
+   Number AbsPnom;
+
+   if(OddDegree) {
       if(UseHull)
-         StringStr << Lin_IntPol(xMaxdt[i], HullRealScaled, HullImagScaled) << "i";
+         StabConstr_Real(xMaxdt, &AbsPnom, NumRoots, 1, RealEV_Scaled, ImagEV_Scaled, 
+                         HullRealScaled, HullImagScaled, dtExp);
       else
-         StringStr << Lin_IntPol(xMaxdt[i], RealEigValsScaled, ImagEigValsScaled) << "i";
-      PseudoExtremaFile << StringStr.str();
-      if(i != n-2)
-         PseudoExtremaFile << "\n";
+         StabConstr_Real(xMaxdt, &AbsPnom, NumRoots, 1, RealEV_Scaled, ImagEV_Scaled, 
+                         RealEigValsScaled, ImagEigValsScaled, dtExp);
    }
-   for(size_t i = i_min + 1; i < n-1; i++) {
-      std::stringstream StringStr; // On purpose within loop (automatic reset)
-      StringStr << std::setprecision(std::numeric_limits<Number>::max_digits10);
-      StringStr << xMaxdt[i] << "+";
+   else {
+      size_t i_min_sol = 0;
+      for(size_t i = 1; i < NumRoots; i++) {
+         if(xMaxdt[i] < xMaxdt[i_min_sol])
+            i_min_sol = i;
+      }
+
       if(UseHull)
-         StringStr << Lin_IntPol(xMaxdt[i], HullRealScaled, HullImagScaled) << "i";
+         StabConstr_Real(xMaxdt, &AbsPnom, NumRoots, 1, RealEV_Scaled, ImagEV_Scaled, 
+                         HullRealScaled, HullImagScaled, ImagDiff_over_RealDiff, dtExp, i_min_sol);
       else
-         StringStr << Lin_IntPol(xMaxdt[i], RealEigValsScaled, ImagEigValsScaled) << "i";
-      PseudoExtremaFile << StringStr.str();
-      if(i != n-2)
-         PseudoExtremaFile << "\n";
+         StabConstr_Real(xMaxdt, &AbsPnom, NumRoots, 1, RealEV_Scaled, ImagEV_Scaled, 
+                         RealEigValsScaled, ImagEigValsScaled, ImagDiff_over_RealDiff, dtExp, i_min_sol);
    }
-   PseudoExtremaFile.close();
+
+   return AbsPnom;
+}
+
+void Roots_Real::set_aggregation(
+   const StabConstrAggregation Aggregation_,
+   const int                   NumBlocks,
+   const Number                AggrParam_
+)
+{
+   Aggregation = Aggregation_;
+   AggrParam   = AggrParam_;
+
+   if(Aggregation == NoAggregation)
+      NumStabConstr = NumEigVals;
+   else {
+      assert(NumBlocks >= 1 && AggrParam > 0.);
+      NumStabConstr = std::min(NumBlocks, NumEigVals);
+      StabConstrValues.resize(NumEigVals);
+   }
+   NumConstr = NumStabConstr + ConsOrder - 1;
+
+   std::cout << "Stability constraints: " << NumStabConstr;
+   if(Aggregation == KS_Aggregation)
+      std::cout << " Kreisselmeier-Steinhauser aggregated with rho = " << AggrParam;
+   else if(Aggregation == PNorm_Aggregation)
+      std::cout << " p-norm aggregated with P = " << AggrParam;
+   std::cout << std::endl << std::endl;
 }
-// [TNLP_finalize_solution]
@@ -7,7 +7,7 @@
 // Authors:  Carl Laird, Andreas Waechter     IBM                    2005-08-16
 //           Daniel Doehring                  RWTH Aachen University 2022-11-20
 
-//#include "IpIpoptCalculatedQuantities.hpp" // To access current original, unscaled violations
+#include "IpIpoptCalculatedQuantities.hpp" // To access current original, unscaled violations
 
 #include "Roots_RealImag.hpp"
 
@@ -18,6 +18,10 @@
 #include <iomanip>
 
 #include "IO_Funcs.hpp"
+#include "WarmStartIO.hpp"
+#include "Checkpoint.hpp"
+#include "ResultBundle.hpp"
+#include "Aggregation.hpp"
 #include "StabConstraints_RealImag.hpp"
 #include "OrderConstraints_RealImag.hpp"
 
@@ -25,6 +29,7 @@
 #include "RKCoeffs.hpp"
 
 using namespace Ipopt;
+using namespace OrderConstr_RealImag;
 
 
 // constructor
@@ -33,7 +38,8 @@ Roots_RealImag::Roots_RealImag(
    const int ConsOrder_,
    const int NumStagesRef_, 
    const Number dtRef_,
-   const std::string EigValFileName
+   const std::string EigValFileName,
+   const Number DedupTol
 ) : NumStages(NumStages_), Degree(NumStages_), ConsOrder(ConsOrder_), NumStagesRef(NumStagesRef_), 
     dtRef(dtRef_), dtExp((dtRef / NumStagesRef_) *  NumStages_)
 {
@@ -44,7 +50,7 @@ Roots_RealImag::Roots_RealImag(
   std::cout << "The expected maximal stable timestep is: " << dtExp  << std::endl << std::endl;
 
   NumEigVals = -1;
-  read_EigVals(EigValFileName, NumEigVals, RealEigValsScaled, ImagEigValsScaled);
+  read_EigVals(EigValFileName, NumEigVals, RealEigValsScaled, ImagEigValsScaled, DedupTol);
 
   for(size_t i = 0; i < NumEigVals; i++) {
     RealEigValsScaled[i] *= dtExp;
@@ -62,12 +68,17 @@ Roots_RealImag::Roots_RealImag(
 
   NumConstr = NumEigVals + ConsOrder - 1; // First order constraint comes for free
 
+  Aggregation   = NoAggregation;
+  NumStabConstr = NumEigVals;
+  AggrParam     = 0.;
+
   OddDegree = Degree % 2;
   NumRoots  = NumStages / 2; // Note: Integer division is here desired
   
   NumUnknowns = 2 * NumRoots + 1;
 
-  read_x0("./Real_Optimized_" + std::to_string(NumStages) + ".txt", xy0, NumUnknowns);
+  const bool Found_x0 = read_x0_Result(NumStages, xy0, NumUnknowns);
+  assert(Found_x0);
   std::cout << "Initial values are: " << std::endl;
   for(size_t i = 0; i < NumUnknowns; i++)
     std::cout << xy0[i] << std::endl;
@@ -75,6 +86,13 @@ Roots_RealImag::Roots_RealImag(
 
   UseHull = false;
   std::cout << "Use hull for interpolation? " << UseHull << std::endl << std::endl;
+
+  WriteOutput        = true;
+  ResultFormat       = "text";
+  CheckpointInterval = 0;
+  IterOffset         = 0;
+  CheckpointFile     = "./Checkpoint_RealImag_" + std::to_string(NumStages) + ".bin";
+  KeepBest           = false;
 }
 
 Roots_RealImag::Roots_RealImag(
@@ -83,7 +101,8 @@ Roots_RealImag::Roots_RealImag(
    const int NumStagesRef_, 
    const Number dtRef_,
    const std::string EigValFileName,
-   const std::string HullPointPath
+   const std::string HullPointPath,
+   const Number DedupTol
 ) : NumStages(NumStages_), Degree(NumStages_), ConsOrder(ConsOrder_), NumStagesRef(NumStagesRef_), 
     dtRef(dtRef_), dtExp((dtRef / NumStagesRef_) *  NumStages_)
 {
@@ -94,7 +113,7 @@ Roots_RealImag::Roots_RealImag(
   std::cout << "The expected maximal stable timestep is: " << dtExp  << std::endl << std::endl;
 
   NumEigVals = -1;
-  read_EigVals(EigValFileName, NumEigVals, RealEigValsScaled, ImagEigValsScaled);
+  read_EigVals(EigValFileName, NumEigVals, RealEigValsScaled, ImagEigValsScaled, DedupTol);
 
   for(size_t i = 0; i < NumEigVals; i++) {
     RealEigValsScaled[i] *= dtExp;
@@ -106,12 +125,17 @@ Roots_RealImag::Roots_RealImag(
 
   NumConstr = NumEigVals + ConsOrder - 1;  // -1 Since one consistency order comes for free
 
+  Aggregation   = NoAggregation;
+  NumStabConstr = NumEigVals;
+  AggrParam     = 0.;
+
   OddDegree = Degree % 2;
   NumRoots  = NumStages / 2; // Note: Integer division is here desired
   
   NumUnknowns = 2 * NumRoots + 1;
 
-  read_x0("./Real_Optimized_" + std::to_string(NumStages) + ".txt", xy0, NumUnknowns);
+  const bool Found_x0 = read_x0_Result(NumStages, xy0, NumUnknowns);
+  assert(Found_x0);
   std::cout << "Initial values are: " << std::endl;
   for(size_t i = 0; i < NumUnknowns; i++)
     std::cout << xy0[i] << std::endl;
@@ -134,6 +158,90 @@ Roots_RealImag::Roots_RealImag(
 
   UseHull = true;
   std::cout << "Use hull for interpolation? " << UseHull << std::endl << std::endl;
+
+  WriteOutput        = true;
+  ResultFormat       = "text";
+  CheckpointInterval = 0;
+  IterOffset         = 0;
+  CheckpointFile     = "./Checkpoint_RealImag_" + std::to_string(NumStages) + ".bin";
+  KeepBest           = false;
+}
+
+Roots_RealImag::Roots_RealImag(
+   const int NumStages_,
+   const int ConsOrder_,
+   const int NumStagesRef_, 
+   const Number dtRef_,
+   const std::vector<Number>& RealEigVals,
+   const std::vector<Number>& ImagEigVals,
+   const std::vector<Number>& HullReal,
+   const std::vector<Number>& HullImag,
+   const std::vector<Number>& xReal
+) : NumStages(NumStages_), Degree(NumStages_), ConsOrder(ConsOrder_), NumStagesRef(NumStagesRef_), 
+    dtRef(dtRef_), dtExp((dtRef / NumStagesRef_) *  NumStages_)
+{
+  std::cout << std::endl << "Optimize a " << Degree << " degree stability polynomial" << std::endl
+            << std::endl << "Optimize roots of the " << Degree - 1 << " \"lower\" degree polynomial" 
+            << std::endl << std::endl;
+
+  std::cout << "The expected maximal stable timestep is: " << dtExp  << std::endl << std::endl;
+
+  assert(RealEigVals.size() == ImagEigVals.size());
+  NumEigVals = RealEigVals.size();
+  RealEigValsScaled = RealEigVals;
+  ImagEigValsScaled = ImagEigVals;
+
+  for(size_t i = 0; i < NumEigVals; i++) {
+    RealEigValsScaled[i] *= dtExp;
+    ImagEigValsScaled[i] *= dtExp;
+  }
+
+  RealMin = *min_element(std::begin(RealEigValsScaled), std::end(RealEigValsScaled));
+  ImagMax = *max_element(std::begin(ImagEigValsScaled), std::end(ImagEigValsScaled));
+
+  NumConstr = NumEigVals + ConsOrder - 1;  // -1 Since one consistency order comes for free
+
+  Aggregation   = NoAggregation;
+  NumStabConstr = NumEigVals;
+  AggrParam     = 0.;
+
+  OddDegree = Degree % 2;
+  NumRoots  = NumStages / 2; // Note: Integer division is here desired
+  
+  NumUnknowns = 2 * NumRoots + 1;
+
+  assert(xReal.size() == NumRoots + 1);
+  xy0 = xReal;
+  xy0.resize(NumUnknowns); // Same layout as 'read_x0': Roots, timestep, zeros
+  std::cout << "Initial values are: " << std::endl;
+  for(size_t i = 0; i < NumUnknowns; i++)
+    std::cout << xy0[i] << std::endl;
+  std::cout << std::endl;
+
+  assert(HullReal.size() == HullImag.size());
+  HullRealScaled = HullReal;
+  HullImagScaled = HullImag;
+
+  for(size_t i = 0; i < HullRealScaled.size(); i++) {
+    HullRealScaled[i] *= dtExp;
+    HullImagScaled[i] *= dtExp;
+  }
+
+  ImagDiff_over_RealDiff.resize(HullRealScaled.size() - 1);
+  for(size_t i = 0; i < HullRealScaled.size()-1; i++) {
+      ImagDiff_over_RealDiff[i] = (HullImagScaled[i+1] - HullImagScaled[i]) / 
+                                  (HullRealScaled[i+1] - HullRealScaled[i]);
+  }
+
+  UseHull = true;
+  std::cout << "Use hull for interpolation? " << UseHull << std::endl << std::endl;
+
+  WriteOutput        = true;
+  ResultFormat       = "text";
+  CheckpointInterval = 0;
+  IterOffset         = 0;
+  CheckpointFile     = "./Checkpoint_RealImag_" + std::to_string(NumStages) + ".bin";
+  KeepBest           = false;
 }
 
 // destructor
@@ -187,7 +295,7 @@ bool Roots_RealImag::get_bounds_info(
    // Omitted for performance
    /*
    assert(n == NumUnknowns);
-   assert(m == NumEigVals+ConsOrder-1);
+   assert(m == NumConstr);
    */
 
    // Real part
@@ -216,14 +324,14 @@ bool Roots_RealImag::get_bounds_info(
    
    xy_u[NumUnknowns-1] = 1.1 * dtExp; // Allow for some increase in maximum timestep
 
-   for( Index i = 0; i < NumEigVals; i++ ) {
+   for( Index i = 0; i < NumStabConstr; i++ ) {
      g_l[i] = 0.; // Automatically ensured by abs, seems to benefit optimization
      //g_l[i] = -2e19; // Two times ipopt default value for treating number as inf - seems to harm here
      
      g_u[i] = 1.; // Actual stability bound
    }
 
-   for ( Index i = NumEigVals; i < NumEigVals + ConsOrder - 1; i++ ) {
+   for ( Index i = NumStabConstr; i < NumConstr; i++ ) {
       g_l[i] = 0.;
       g_u[i] = 0.;
    }
@@ -264,16 +372,34 @@ bool Roots_RealImag::get_starting_point(
    xy[NumUnknowns - 1] = xy0[NumRoots];
    //xy[NumUnknowns - 1] = dtExp;
 
+   // Warmstart from a previous solution (including the imaginary corrections)
+   if(xyWarm.size() == NumUnknowns)
+      for( Index i = 0; i < NumUnknowns; i++ ) {
+         xy[i] = xyWarm[i];
+      }
+
+   // Reset best iterate (relevant for repeated optimizations), unless resumed
+   if(!KeepBest) {
+      xyBest.assign(xy, xy + NumUnknowns);
+      zLBest     = (zL0.size() == NumUnknowns) ? zL0 : std::vector<Number>(NumUnknowns, 0.);
+      zUBest     = (zU0.size() == NumUnknowns) ? zU0 : std::vector<Number>(NumUnknowns, 0.);
+      lambdaBest = (lambda0.size() == NumConstr) ? lambda0 : std::vector<Number>(NumConstr, 0.);
+      BestObj   = 0.;
+      BestInfPr = 42e6;
+   }
+   KeepBest = false;
+   Budget.start();
+
    if(init_z) {
      for(Index i = 0; i < NumUnknowns; i++) {
-        z_L[i] = 0.;
-        z_U[i] = 0.;
+        z_L[i] = (zL0.size() == NumUnknowns) ? zL0[i] : 0.;
+        z_U[i] = (zU0.size() == NumUnknowns) ? zU0[i] : 0.;
      }
   }
 
    if(init_lambda)
       for( Index i = 0; i < m; i++ ) {
-         lambda[i] = 0.;
+         lambda[i] = (lambda0.size() == m) ? lambda0[i] : 0.;
       }
 
    return true;
@@ -317,6 +443,71 @@ bool Roots_RealImag::eval_grad_f(
 }
 // [TNLP_eval_grad_f]
 
+void Roots_RealImag::eval_StabConstr(
+   const Number* xy,
+   Number*       gStab
+)
+{
+   if(OddDegree) {
+      if(UseHull)
+         StabConstr_RealImag(xy, gStab, NumRoots, NumEigVals, RealEigValsScaled, ImagEigValsScaled, 
+                             HullRealScaled, HullImagScaled, dtExp);
+      else
+         StabConstr_RealImag(xy, gStab, NumRoots, NumEigVals, RealEigValsScaled, ImagEigValsScaled, dtExp);
+   }
+   else {
+      i_min = 0;
+      for(size_t i = 1; i < NumRoots; i++) {
+         if(xy[i] < xy[i_min])
+            i_min = i;
+      }
+
+      if(UseHull)
+         StabConstr_RealImag(xy, gStab, NumRoots, NumEigVals, RealEigValsScaled, ImagEigValsScaled, 
+                             HullRealScaled, HullImagScaled, ImagDiff_over_RealDiff, dtExp, i_min);
+      else
+         StabConstr_RealImag(xy, gStab, NumRoots, NumEigVals, RealEigValsScaled, ImagEigValsScaled, 
+                             ImagDiff_over_RealDiff, dtExp, i_min);
+   }
+}
+
+template<typename T>
+T Roots_RealImag::StabConstr_i(
+   const std::vector<T>& xy,
+   const size_t          i
+)
+{
+   if(OddDegree) {
+      if(UseHull)
+         return StabConstr_RealImag_i(xy, NumRoots, RealEigValsScaled, ImagEigValsScaled, i, 
+                                      HullRealScaled, HullImagScaled, dtExp);
+      else
+         return StabConstr_RealImag_i(xy, NumRoots, RealEigValsScaled, ImagEigValsScaled, i, dtExp);
+   }
+   else {
+      if(UseHull)
+         return StabConstr_RealImag_i(xy, NumRoots, RealEigValsScaled, ImagEigValsScaled, i, 
+                                      HullRealScaled, HullImagScaled, ImagDiff_over_RealDiff, dtExp, i_min);
+      else
+         return StabConstr_RealImag_i(xy, NumRoots, RealEigValsScaled, ImagEigValsScaled, i, 
+                                      ImagDiff_over_RealDiff, dtExp, i_min);
+   }
+}
+
+template<typename T>
+T Roots_RealImag::aggregate_StabConstr(
+   const T*     gStab,
+   const size_t Block
+) const
+{
+   const size_t i_begin = BlockBegin(Block,     NumStabConstr, NumEigVals);
+   const size_t i_end   = BlockBegin(Block + 1, NumStabConstr, NumEigVals);
+
+   // Passive maximum of the block as shift (prevents overflow for large aggregation parameters)
+   return Aggregate(Aggregation, gStab + i_begin, i_end - i_begin, AggrParam, 
+                    BlockShift(StabConstrValues.data() + i_begin, i_end - i_begin));
+}
+
 // [TNLP_eval_g]
 // return the value of the constraints: g(x)
 bool Roots_RealImag::eval_g(
@@ -330,72 +521,62 @@ bool Roots_RealImag::eval_g(
    // Removed for performance
    /*
    assert(n == NumUnknowns);
-   assert(m == NumEigVals+ConsOrder-1);
+   assert(m == NumConstr);
    */
    
-   if(OddDegree) {
-      if(UseHull)
-         StabConstr_RealImag(xy, g, NumRoots, NumEigVals, RealEigValsScaled, ImagEigValsScaled, HullRealScaled, HullImagScaled, dtExp);
-      else   
-         StabConstr_RealImag(xy, g, NumRoots, NumEigVals, RealEigValsScaled, ImagEigValsScaled, dtExp);
+   if(Aggregation == NoAggregation)
+      eval_StabConstr(xy, g); // Also determines 'i_min'
+   else {
+      eval_StabConstr(xy, StabConstrValues.data());
+      for(size_t b = 0; b < NumStabConstr; b++)
+         g[b] = aggregate_StabConstr(StabConstrValues.data(), b);
+   }
 
+   if(OddDegree) {
       if(ConsOrder >= 2) {
          if(UseHull)
-            SecOrder(xy, g, NumRoots, NumEigVals, HullRealScaled, HullImagScaled);
+            SecOrder(xy, g, NumRoots, NumStabConstr, HullRealScaled, HullImagScaled);
          else
-            SecOrder(xy, g, NumRoots, NumEigVals, RealEigValsScaled, ImagEigValsScaled);
+            SecOrder(xy, g, NumRoots, NumStabConstr, RealEigValsScaled, ImagEigValsScaled);
 
          if(ConsOrder >= 3) {
             if(UseHull)
-               ThirdOrder(xy, g, NumRoots, NumEigVals, HullRealScaled, HullImagScaled);
+               ThirdOrder(xy, g, NumRoots, NumStabConstr, HullRealScaled, HullImagScaled);
             else
-               ThirdOrder(xy, g, NumRoots, NumEigVals, RealEigValsScaled, ImagEigValsScaled);
+               ThirdOrder(xy, g, NumRoots, NumStabConstr, RealEigValsScaled, ImagEigValsScaled);
 
             if(ConsOrder == 4) {
                if(UseHull)
-                  FourthOrder(xy, g, NumRoots, NumEigVals, HullRealScaled, HullImagScaled);
+                  FourthOrder(xy, g, NumRoots, NumStabConstr, HullRealScaled, HullImagScaled);
                else
-                  FourthOrder(xy, g, NumRoots, NumEigVals, RealEigValsScaled, ImagEigValsScaled);
+                  FourthOrder(xy, g, NumRoots, NumStabConstr, RealEigValsScaled, ImagEigValsScaled);
             }
          }
       }
    }
    else {
-      i_min = 0;
-      for(size_t i = 1; i < NumRoots; i++) {
-         if(xy[i] < xy[i_min])
-            i_min = i;
-      }
-
-      if(UseHull)
-         StabConstr_RealImag(xy, g, NumRoots, NumEigVals, RealEigValsScaled, ImagEigValsScaled, 
-                             HullRealScaled, HullImagScaled, ImagDiff_over_RealDiff, dtExp, i_min);
-      else   
-         StabConstr_RealImag(xy, g, NumRoots, NumEigVals, RealEigValsScaled, ImagEigValsScaled, 
-                             ImagDiff_over_RealDiff, dtExp, i_min);
-
       if(ConsOrder >= 2) {
          if(UseHull)
-            SecOrder(xy, g, NumRoots, NumEigVals, HullRealScaled, HullImagScaled, 
+            SecOrder(xy, g, NumRoots, NumStabConstr, HullRealScaled, HullImagScaled, 
                      ImagDiff_over_RealDiff, i_min);
          else
-            SecOrder(xy, g, NumRoots, NumEigVals, RealEigValsScaled, ImagEigValsScaled, 
+            SecOrder(xy, g, NumRoots, NumStabConstr, RealEigValsScaled, ImagEigValsScaled, 
                      ImagDiff_over_RealDiff, i_min);
 
          if(ConsOrder >= 3) {
             if(UseHull)
-               ThirdOrder(xy, g, NumRoots, NumEigVals, HullRealScaled, HullImagScaled, 
+               ThirdOrder(xy, g, NumRoots, NumStabConstr, HullRealScaled, HullImagScaled, 
                           ImagDiff_over_RealDiff, i_min);
             else
-               ThirdOrder(xy, g, NumRoots, NumEigVals, RealEigValsScaled, ImagEigValsScaled, 
+               ThirdOrder(xy, g, NumRoots, NumStabConstr, RealEigValsScaled, ImagEigValsScaled, 
                           ImagDiff_over_RealDiff, i_min);
 
             if(ConsOrder == 4) {
                if(UseHull)
-                  FourthOrder(xy, g, NumRoots, NumEigVals, HullRealScaled, HullImagScaled, 
+                  FourthOrder(xy, g, NumRoots, NumStabConstr, HullRealScaled, HullImagScaled, 
                               ImagDiff_over_RealDiff, i_min);
                else
-                  FourthOrder(xy, g, NumRoots, NumEigVals, RealEigValsScaled, ImagEigValsScaled, 
+                  FourthOrder(xy, g, NumRoots, NumStabConstr, RealEigValsScaled, ImagEigValsScaled, 
                               ImagDiff_over_RealDiff, i_min);
             }
          }
@@ -422,7 +603,7 @@ bool Roots_RealImag::eval_jac_g(
    // Removed for performance
    /*
    assert(n == NumUnknowns);
-   assert(m == NumEigVals+ConsOrder-1);
+   assert(m == NumConstr);
    */
 
    if( values == NULL )
@@ -456,11 +637,19 @@ bool Roots_RealImag::eval_jac_g(
       DCO_M::global_tape->register_variable(xy_dco);
 
       std::vector<DCO_T> g(m);
+      std::vector<DCO_T> gStabAggr; // Non-aggregated stability constraints in case of aggregation
+
+      if(Aggregation != NoAggregation) {
+         eval_StabConstr(xy, StabConstrValues.data()); // Passive values for the shifts
+         gStabAggr.resize(NumEigVals);
+      }
+      std::vector<DCO_T>& gStab = (Aggregation == NoAggregation) ? g : gStabAggr;
+
       if(OddDegree) {
          if(UseHull)
-            StabConstr_RealImag(xy_dco, g, NumRoots, NumEigVals, RealEigValsScaled, ImagEigValsScaled, HullRealScaled, HullImagScaled, dtExp);
+            StabConstr_RealImag(xy_dco, gStab, NumRoots, NumEigVals, RealEigValsScaled, ImagEigValsScaled, HullRealScaled, HullImagScaled, dtExp);
          else
-            StabConstr_RealImag(xy_dco, g, NumRoots, NumEigVals, RealEigValsScaled, ImagEigValsScaled, dtExp);
+            StabConstr_RealImag(xy_dco, gStab, NumRoots, NumEigVals, RealEigValsScaled, ImagEigValsScaled, dtExp);
       }
       else {
          i_min = 0;
@@ -470,17 +659,21 @@ bool Roots_RealImag::eval_jac_g(
          }
 
          if(UseHull)
-            StabConstr_RealImag(xy_dco, g, NumRoots, NumEigVals, RealEigValsScaled, ImagEigValsScaled, 
+            StabConstr_RealImag(xy_dco, gStab, NumRoots, NumEigVals, RealEigValsScaled, ImagEigValsScaled, 
                                 HullRealScaled, HullImagScaled, ImagDiff_over_RealDiff, dtExp, i_min);
          else
-            StabConstr_RealImag(xy_dco, g, NumRoots, NumEigVals, RealEigValsScaled, ImagEigValsScaled, 
+            StabConstr_RealImag(xy_dco, gStab, NumRoots, NumEigVals, RealEigValsScaled, ImagEigValsScaled, 
                                 ImagDiff_over_RealDiff, dtExp, i_min);
       }
 
+      if(Aggregation != NoAggregation)
+         for(size_t b = 0; b < NumStabConstr; b++)
+            g[b] = aggregate_StabConstr(gStabAggr.data(), b);
+
       DCO_M::global_tape->register_output_variable(g); // Record active output
 
       size_t ind = 0;
-      for(size_t i = 0; i < NumEigVals; i++) {
+      for(size_t i = 0; i < NumStabConstr; i++) {
          dco::derivative(g)[i] = 1.; // Seed first component
 
          DCO_M::global_tape->interpret_adjoint(); // Interpret (stored) tape
@@ -498,20 +691,20 @@ bool Roots_RealImag::eval_jac_g(
       if(ConsOrder >= 2) {
          if(OddDegree) {
             if(UseHull)
-               SecOrder(xy_dco, g, NumRoots, NumEigVals, HullRealScaled, HullImagScaled);
+               SecOrder(xy_dco, g, NumRoots, NumStabConstr, HullRealScaled, HullImagScaled);
             else            
-               SecOrder(xy_dco, g, NumRoots, NumEigVals, RealEigValsScaled, ImagEigValsScaled);
+               SecOrder(xy_dco, g, NumRoots, NumStabConstr, RealEigValsScaled, ImagEigValsScaled);
          }
          else {
             if(UseHull)
-               SecOrder(xy_dco, g, NumRoots, NumEigVals, HullRealScaled, HullImagScaled, 
+               SecOrder(xy_dco, g, NumRoots, NumStabConstr, HullRealScaled, HullImagScaled, 
                         ImagDiff_over_RealDiff, i_min);
             else            
-               SecOrder(xy_dco, g, NumRoots, NumEigVals, RealEigValsScaled, ImagEigValsScaled, 
+               SecOrder(xy_dco, g, NumRoots, NumStabConstr, RealEigValsScaled, ImagEigValsScaled, 
                         ImagDiff_over_RealDiff, i_min);
          }
          
-         dco::derivative(g)[NumEigVals] = 1.; // Seed component
+         dco::derivative(g)[NumStabConstr] = 1.; // Seed component
 
          DCO_M::global_tape->interpret_adjoint(); // Interpret (stored) tape
 
@@ -527,20 +720,20 @@ bool Roots_RealImag::eval_jac_g(
             
             if(OddDegree) {
                if(UseHull)
-                  ThirdOrder(xy_dco, g, NumRoots, NumEigVals, HullRealScaled, HullImagScaled);
+                  ThirdOrder(xy_dco, g, NumRoots, NumStabConstr, HullRealScaled, HullImagScaled);
                else            
-                  ThirdOrder(xy_dco, g, NumRoots, NumEigVals, RealEigValsScaled, ImagEigValsScaled);
+                  ThirdOrder(xy_dco, g, NumRoots, NumStabConstr, RealEigValsScaled, ImagEigValsScaled);
             }
             else {
                if(UseHull)
-                  ThirdOrder(xy_dco, g, NumRoots, NumEigVals, HullRealScaled, HullImagScaled, 
+                  ThirdOrder(xy_dco, g, NumRoots, NumStabConstr, HullRealScaled, HullImagScaled, 
                              ImagDiff_over_RealDiff, i_min);
                else            
-                  ThirdOrder(xy_dco, g, NumRoots, NumEigVals, RealEigValsScaled, ImagEigValsScaled, 
+                  ThirdOrder(xy_dco, g, NumRoots, NumStabConstr, RealEigValsScaled, ImagEigValsScaled, 
                              ImagDiff_over_RealDiff, i_min);
             }
             
-            dco::derivative(g)[NumEigVals+1] = 1.; // Seed component
+            dco::derivative(g)[NumStabConstr+1] = 1.; // Seed component
 
             DCO_M::global_tape->interpret_adjoint(); // Interpret (stored) tape
 
@@ -556,20 +749,20 @@ bool Roots_RealImag::eval_jac_g(
                
                if(OddDegree) {
                   if(UseHull)
-                     FourthOrder(xy_dco, g, NumRoots, NumEigVals, HullRealScaled, HullImagScaled);
+                     FourthOrder(xy_dco, g, NumRoots, NumStabConstr, HullRealScaled, HullImagScaled);
                   else            
-                     FourthOrder(xy_dco, g, NumRoots, NumEigVals, RealEigValsScaled, ImagEigValsScaled);
+                     FourthOrder(xy_dco, g, NumRoots, NumStabConstr, RealEigValsScaled, ImagEigValsScaled);
                }
                else {
                   if(UseHull)
-                     FourthOrder(xy_dco, g, NumRoots, NumEigVals, HullRealScaled, HullImagScaled, 
+                     FourthOrder(xy_dco, g, NumRoots, NumStabConstr, HullRealScaled, HullImagScaled, 
                                  ImagDiff_over_RealDiff, i_min);
                   else            
-                     FourthOrder(xy_dco, g, NumRoots, NumEigVals, RealEigValsScaled, ImagEigValsScaled, 
+                     FourthOrder(xy_dco, g, NumRoots, NumStabConstr, RealEigValsScaled, ImagEigValsScaled, 
                                  ImagDiff_over_RealDiff, i_min);
                }
                
-               dco::derivative(g)[NumEigVals+2] = 1.; // Seed component
+               dco::derivative(g)[NumStabConstr+2] = 1.; // Seed component
 
                DCO_M::global_tape->interpret_adjoint(); // Interpret (stored) tape
 
@@ -609,7 +802,7 @@ bool Roots_RealImag::eval_h(
    // Removed for efficiency
    /*
    assert(n == NumUnknowns);
-   assert(m == NumEigVals+ConsOrder-1);
+   assert(m == NumConstr);
    */
 
    if( values == NULL )
@@ -652,84 +845,38 @@ bool Roots_RealImag::eval_h(
 
       DCO_T g; // Scalar output
 
-      for (size_t i = 0; i < NumUnknowns; i++) {
-         DCO_BM::global_tape->register_variable(dco::value(xy_dco[i]) ); // record active input
-         DCO_BM::global_tape->register_variable(dco::derivative(xy_dco[i]) ); // record active input
-
-         dco::value(dco::value(xy_dco[i]) ) = xy[i];
-
-         DCO_M::global_tape->register_variable(xy_dco[i]);
-      }
-
-      if(OddDegree) {
-         if(UseHull)
-            g = StabConstr_RealImag_i(xy_dco, NumRoots, RealEigValsScaled, ImagEigValsScaled, 0, 
-                                      HullRealScaled, HullImagScaled, dtExp);
-         else
-            g = StabConstr_RealImag_i(xy_dco, NumRoots, RealEigValsScaled, ImagEigValsScaled, 0, dtExp);
-      }
-      else {
-         i_min = 0;
-         for(size_t i = 1; i < NumRoots; i++) {
-            if(xy[i] < xy[i_min])
-               i_min = i;
-         }
-
-         if(UseHull)
-            g = StabConstr_RealImag_i(xy_dco, NumRoots, RealEigValsScaled, ImagEigValsScaled, 0, 
-                                      HullRealScaled, HullImagScaled, ImagDiff_over_RealDiff, dtExp, i_min);
-         else
-            g = StabConstr_RealImag_i(xy_dco, NumRoots, RealEigValsScaled, ImagEigValsScaled, 0, 
-                                      ImagDiff_over_RealDiff, dtExp, i_min);
-      }
-
-      dco::value(dco::derivative(g) ) = 1.; // Seed
-      DCO_M::global_tape->interpret_adjoint();
-
       int ind = 0;
-      for(size_t i = 0; i < NumUnknowns; i++) {
-         dco::derivative(dco::derivative(xy_dco[i]) ) = 1.; // Seed
 
-         DCO_BM::global_tape->interpret_adjoint();
-         for(size_t j = 0; j <= i; j++) {
-            values[ind] = lambda[0] * dco::derivative(dco::value(xy_dco[j]) );
-            ind++;
-         }
+      if(Aggregation == NoAggregation) {
+         /// First Eigenvalue ///
+         for (size_t i = 0; i < NumUnknowns; i++) {
+            DCO_BM::global_tape->register_variable(dco::value(xy_dco[i]) ); // record active input
+            DCO_BM::global_tape->register_variable(dco::derivative(xy_dco[i]) ); // record active input
 
-         //dco::derivative(dco::derivative(xy_dco[i]) ) = 0.; // Unseed
+            dco::value(dco::value(xy_dco[i]) ) = xy[i];
 
-         DCO_BM::global_tape->zero_adjoints();
-      }
-
-      // Clear tape only, do not remove
-      DCO_M::global_tape->reset();
-      DCO_BM::global_tape->reset();
-
-      /// Remaining Eigenvalues ///
-      for(size_t i = 1; i < NumEigVals; i++) {
-         for (size_t j = 0; j < NumUnknowns; j++) {
-            DCO_BM::global_tape->register_variable(dco::value(xy_dco[j]) ); // record active input
-            DCO_BM::global_tape->register_variable(dco::derivative(xy_dco[j]) ); // record active input
-
-            dco::value(dco::value(xy_dco[j]) ) = xy[j];
-
-            DCO_M::global_tape->register_variable(xy_dco[j]);
+            DCO_M::global_tape->register_variable(xy_dco[i]);
          }
 
          if(OddDegree) {
             if(UseHull)
-               g = StabConstr_RealImag_i(xy_dco, NumRoots, RealEigValsScaled, ImagEigValsScaled, i, 
+               g = StabConstr_RealImag_i(xy_dco, NumRoots, RealEigValsScaled, ImagEigValsScaled, 0, 
                                          HullRealScaled, HullImagScaled, dtExp);
             else
-               g = StabConstr_RealImag_i(xy_dco, NumRoots, RealEigValsScaled, ImagEigValsScaled, i, dtExp);
+               g = StabConstr_RealImag_i(xy_dco, NumRoots, RealEigValsScaled, ImagEigValsScaled, 0, dtExp);
          }
          else {
+            i_min = 0;
+            for(size_t i = 1; i < NumRoots; i++) {
+               if(xy[i] < xy[i_min])
+                  i_min = i;
+            }
+
             if(UseHull)
-               g = StabConstr_RealImag_i(xy_dco, NumRoots, RealEigValsScaled, ImagEigValsScaled, i, 
-                                         HullRealScaled, HullImagScaled, 
-                                         ImagDiff_over_RealDiff, dtExp, i_min);
+               g = StabConstr_RealImag_i(xy_dco, NumRoots, RealEigValsScaled, ImagEigValsScaled, 0, 
+                                         HullRealScaled, HullImagScaled, ImagDiff_over_RealDiff, dtExp, i_min);
             else
-               g = StabConstr_RealImag_i(xy_dco, NumRoots, RealEigValsScaled, ImagEigValsScaled, i, 
+               g = StabConstr_RealImag_i(xy_dco, NumRoots, RealEigValsScaled, ImagEigValsScaled, 0, 
                                          ImagDiff_over_RealDiff, dtExp, i_min);
          }
 
@@ -737,25 +884,127 @@ bool Roots_RealImag::eval_h(
          DCO_M::global_tape->interpret_adjoint();
 
          ind = 0;
-         for(size_t k = 0; k < NumUnknowns; k++) {
-            dco::derivative(dco::derivative(xy_dco[k]) ) = 1.; // Seed
+         for(size_t i = 0; i < NumUnknowns; i++) {
+            dco::derivative(dco::derivative(xy_dco[i]) ) = 1.; // Seed
 
             DCO_BM::global_tape->interpret_adjoint();
-            for(size_t j = 0; j <= k; j++) {
-               values[ind] += lambda[i] * dco::derivative(dco::value(xy_dco[j]) );
+            for(size_t j = 0; j <= i; j++) {
+               values[ind] = lambda[0] * dco::derivative(dco::value(xy_dco[j]) );
                ind++;
             }
 
-            //dco::derivative(dco::derivative(xy_dco[k]) ) = 0.; // Unseed
+            //dco::derivative(dco::derivative(xy_dco[i]) ) = 0.; // Unseed
 
             DCO_BM::global_tape->zero_adjoints();
          }
+
          // Clear tape only, do not remove
          DCO_M::global_tape->reset();
          DCO_BM::global_tape->reset();
+
+         /// Remaining Eigenvalues ///
+         for(size_t i = 1; i < NumEigVals; i++) {
+            for (size_t j = 0; j < NumUnknowns; j++) {
+               DCO_BM::global_tape->register_variable(dco::value(xy_dco[j]) ); // record active input
+               DCO_BM::global_tape->register_variable(dco::derivative(xy_dco[j]) ); // record active input
+
+               dco::value(dco::value(xy_dco[j]) ) = xy[j];
+
+               DCO_M::global_tape->register_variable(xy_dco[j]);
+            }
+
+            if(OddDegree) {
+               if(UseHull)
+                  g = StabConstr_RealImag_i(xy_dco, NumRoots, RealEigValsScaled, ImagEigValsScaled, i, 
+                                            HullRealScaled, HullImagScaled, dtExp);
+               else
+                  g = StabConstr_RealImag_i(xy_dco, NumRoots, RealEigValsScaled, ImagEigValsScaled, i, dtExp);
+            }
+            else {
+               if(UseHull)
+                  g = StabConstr_RealImag_i(xy_dco, NumRoots, RealEigValsScaled, ImagEigValsScaled, i, 
+                                            HullRealScaled, HullImagScaled, 
+                                            ImagDiff_over_RealDiff, dtExp, i_min);
+               else
+                  g = StabConstr_RealImag_i(xy_dco, NumRoots, RealEigValsScaled, ImagEigValsScaled, i, 
+                                            ImagDiff_over_RealDiff, dtExp, i_min);
+            }
+
+            dco::value(dco::derivative(g) ) = 1.; // Seed
+            DCO_M::global_tape->interpret_adjoint();
+
+            ind = 0;
+            for(size_t k = 0; k < NumUnknowns; k++) {
+               dco::derivative(dco::derivative(xy_dco[k]) ) = 1.; // Seed
+
+               DCO_BM::global_tape->interpret_adjoint();
+               for(size_t j = 0; j <= k; j++) {
+                  values[ind] += lambda[i] * dco::derivative(dco::value(xy_dco[j]) );
+                  ind++;
+               }
+
+               //dco::derivative(dco::derivative(xy_dco[k]) ) = 0.; // Unseed
+
+               DCO_BM::global_tape->zero_adjoints();
+            }
+            // Clear tape only, do not remove
+            DCO_M::global_tape->reset();
+            DCO_BM::global_tape->reset();
+         }
+      }
+      else {
+         /// Aggregated blocks of eigenvalues ///
+         eval_StabConstr(xy, StabConstrValues.data()); // Passive values for the shifts, also 'i_min'
+
+         for(ind = 0; ind < nele_hess; ind++)
+            values[ind] = 0.;
+
+         std::vector<DCO_T> gStab; // Non-negligible constraints of the block
+         gStab.reserve(NumEigVals);
+         for(size_t b = 0; b < NumStabConstr; b++) {
+            const size_t i_begin = BlockBegin(b,     NumStabConstr, NumEigVals);
+            const size_t i_end   = BlockBegin(b + 1, NumStabConstr, NumEigVals);
+            const Number Shift   = BlockShift(StabConstrValues.data() + i_begin, i_end - i_begin);
+
+            for (size_t j = 0; j < NumUnknowns; j++) {
+               DCO_BM::global_tape->register_variable(dco::value(xy_dco[j]) ); // record active input
+               DCO_BM::global_tape->register_variable(dco::derivative(xy_dco[j]) ); // record active input
+
+               dco::value(dco::value(xy_dco[j]) ) = xy[j];
+
+               DCO_M::global_tape->register_variable(xy_dco[j]);
+            }
+
+            // Tape only eigenvalues that contribute to the Hessian of the aggregate
+            gStab.clear();
+            for(size_t i = i_begin; i < i_end; i++)
+               if(!HessianNegligible(Aggregation, StabConstrValues[i], AggrParam, Shift))
+                  gStab.push_back(StabConstr_i(xy_dco, i));
+            g = Aggregate(Aggregation, gStab.data(), gStab.size(), AggrParam, Shift);
+
+            dco::value(dco::derivative(g) ) = 1.; // Seed
+            DCO_M::global_tape->interpret_adjoint(); // Back-propagate from output/adjoint
+
+            ind = 0;
+            for(size_t k = 0; k < NumUnknowns; k++) {
+               dco::derivative(dco::derivative(xy_dco[k]) ) = 1.; // Seed
+
+               DCO_BM::global_tape->interpret_adjoint(); // Back-propagate from output/adjoint
+               for(size_t j = 0; j <= k; j++) {
+                  values[ind] += lambda[b] * dco::derivative(dco::value(xy_dco[j]) );
+                  ind++;
+               }
+
+               DCO_BM::global_tape->zero_adjoints(); // Unseed
+            }
+
+            // Clear tape only, do not remove
+            DCO_M::global_tape->reset();
+            DCO_BM::global_tape->reset();
+         }
       }
 
-      /// Stability constraints ///
+      /// Order constraints ///
 
       if(ConsOrder >= 2) {
          for (size_t j = 0; j < NumUnknowns; j++) {
@@ -791,7 +1040,7 @@ bool Roots_RealImag::eval_h(
 
             DCO_BM::global_tape->interpret_adjoint(); // Back-propagate from output/adjoint
             for(size_t j = 0; j <= k; j++) {
-               values[ind] += lambda[NumEigVals] * dco::derivative(dco::value(xy_dco[j]) );
+               values[ind] += lambda[NumStabConstr] * dco::derivative(dco::value(xy_dco[j]) );
                ind++;
             }
 
@@ -832,7 +1081,7 @@ bool Roots_RealImag::eval_h(
 
                DCO_BM::global_tape->interpret_adjoint(); // Back-propagate from output/adjoint
                for(size_t j = 0; j <= k; j++) {
-                  values[ind] += lambda[NumEigVals+1] * dco::derivative(dco::value(xy_dco[j]) );
+                  values[ind] += lambda[NumStabConstr + 1] * dco::derivative(dco::value(xy_dco[j]) );
                   ind++;
                }
 
@@ -873,7 +1122,7 @@ bool Roots_RealImag::eval_h(
 
                   DCO_BM::global_tape->interpret_adjoint(); // Back-propagate from output/adjoint
                   for(size_t j = 0; j <= k; j++) {
-                     values[ind] += lambda[NumEigVals+2] * dco::derivative(dco::value(xy_dco[j]) );
+                     values[ind] += lambda[NumStabConstr + 2] * dco::derivative(dco::value(xy_dco[j]) );
                      ind++;
                   }
 
@@ -918,7 +1167,24 @@ bool Roots_RealImag::intermediate_callback(
          return true;
    }
    */
-   return true;
+
+   // Track best iterate as in 'Roots_Real'
+   if(mode == RegularMode) { // Otherwise 'ip_cq->unscaled_curr_nlp_constraint_violation(NORM_MAX)' returns erronous 0!
+      const Number CurrInfPr = ip_cq->unscaled_curr_nlp_constraint_violation(NORM_MAX);
+      // Comparable feasibility: Prefer larger timestep, otherwise prefer less infeasible iterate
+      if((fabs(CurrInfPr - BestInfPr) < 1e-12 && obj_value < BestObj) || 
+         (fabs(CurrInfPr - BestInfPr) >= 1e-12 && CurrInfPr < BestInfPr)) {
+         BestObj   = obj_value;
+         BestInfPr = CurrInfPr;
+         get_curr_iterate(ip_data, ip_cq, false, NumUnknowns, xyBest.data(), zLBest.data(), zUBest.data(), 
+                          NumConstr, NULL, lambdaBest.data());
+      }
+   }
+
+   if(CheckpointInterval > 0 && mode == RegularMode && iter > 0 && iter % CheckpointInterval == 0)
+      write_checkpoint(iter, mu, ip_data, ip_cq);
+
+   return Budget.check(iter, -BestObj, BestInfPr);
 }
 // [TNLP_intermediate_callback]
 
@@ -937,8 +1203,29 @@ void Roots_RealImag::finalize_solution(
    IpoptCalculatedQuantities* ip_cq
 )
 {
+   // Stopped by time budget or stagnation: Use best instead of last iterate (with its multipliers)
+   if(status == USER_REQUESTED_STOP && !xyBest.empty()) {
+      std::cout << std::endl << "Solve stopped, use best iterate (infeasibility " << BestInfPr << ")" << std::endl;
+      xy     = xyBest.data();
+      z_L    = zLBest.data();
+      z_U    = zUBest.data();
+      lambda = lambdaBest.data();
+   }
+
    // here is where we would store the solution to variables, or write to a file, etc
    // so we could use the solution.
+   xyOpt.assign(xy, xy + n);
+   zLOpt.assign(z_L, z_L + n);
+   zUOpt.assign(z_U, z_U + n);
+   lambdaOpt.assign(lambda, lambda + m);
+
+   if(!WarmStartFile.empty())
+      write_WarmStart(WarmStartFile, xyOpt, zLOpt, zUOpt, lambdaOpt);
+
+   // Converged: Checkpoint is obsolete
+   if(status == SUCCESS && CheckpointInterval > 0)
+      std::remove(CheckpointFile.c_str());
+
    std::cout.precision(std::numeric_limits<Number>::max_digits10);
    std::cout << std::endl << std::endl << std::endl << "### RESULTS ###" << std::endl;
 
@@ -997,7 +1284,7 @@ void Roots_RealImag::finalize_solution(
              << std::endl << "and a reference timestep of: " << dtExp 
              << std::endl << std::endl;
 
-   Number Constr[NumConstr];
+   Number Constr[NumEigVals + ConsOrder - 1]; // Always the exact (non-aggregated) constraints
    if(OddDegree)
       if(UseHull)
          StabConstr_RealImag(xy, Constr, NumRoots, NumEigVals, RealEigValsScaled, ImagEigValsScaled, HullRealScaled, HullImagScaled, dtExp);
@@ -1079,6 +1366,44 @@ void Roots_RealImag::finalize_solution(
       }
    }
 
+   // Intermediate solves (aggregation continuation, coarse levels): Neither files nor P-ERK coefficients
+   if(!WriteOutput)
+      return;
+
+   if(ResultFormat != "bundle")
+      write_solution_files(xy);
+
+   // Make P-ERK ready
+   std::vector<MP_Real> gamma, a, SE_Factors;
+   compute_a_coeffs(NumStages, NumStages, OddDegree, ConsOrder, Reals, Imags, 
+                    NumEigVals, RealEigValsScaled, ImagEigValsScaled, xy[n-1], dtExp,
+                    ResultFormat != "bundle", &gamma, &a, &SE_Factors);
+
+   if(ResultFormat != "text") {
+      ResultBundle Bundle("RealImag", NumStages, ConsOrder);
+      Bundle.add("x", xy, n);
+      Bundle.add("roots_real", Reals);
+      Bundle.add("roots_imag", Imags);
+      Bundle.add("constraints", Constr, NumEigVals + ConsOrder - 1);
+      Bundle.add("z_L", zLOpt);
+      Bundle.add("z_U", zUOpt);
+      Bundle.add("lambda", lambdaOpt);
+      Bundle.add_MP("gamma", gamma);
+      Bundle.add_MP("a", a);
+      Bundle.add_MP("SE_Factors", SE_Factors);
+
+      if(!Bundle.write(xy[n-1]))
+         std::cout << "CARE: Could not write result bundle " << ResultBundlePrefix("RealImag", NumStages) << std::endl;
+   }
+}
+// [TNLP_finalize_solution]
+
+void Roots_RealImag::write_solution_files(
+   const Number* xy
+)
+{
+   const Index n = NumUnknowns;
+
    std::ofstream RealImagOptFile("./RealImag_Optimized_" + std::to_string(NumStages) + ".txt");
    for(size_t i = 0; i < n/2; i++) {
       std::stringstream StringStr; // On purpose within loop (automatic reset)
@@ -1140,9 +1465,158 @@ void Roots_RealImag::finalize_solution(
          TrueComplexFile << "\n";
     }
     TrueComplexFile.close();
+}
 
-   // Make P-ERK ready
-   compute_a_coeffs(NumStages, NumStages, OddDegree, ConsOrder, Reals, Imags, 
-                    NumEigVals, RealEigValsScaled, ImagEigValsScaled, xy[n-1], dtExp);
+void Roots_RealImag::set_result_format(
+   const std::string Format
+)
+{
+   assert(Format == "text" || Format == "bundle" || Format == "both");
+   ResultFormat = Format;
+}
+
+void Roots_RealImag::set_checkpointing(
+   const Index Interval
+)
+{
+   CheckpointInterval = Interval;
+}
+
+void Roots_RealImag::write_checkpoint(
+   const Index                iter,
+   const Number               mu,
+   const IpoptData*           ip_data,
+   IpoptCalculatedQuantities* ip_cq
+)
+{
+   Checkpoint State;
+   State.Signature = ProblemSignature("RealImag", NumStages, ConsOrder, NumStagesRef, dtRef, 
+                                      RealEigValsScaled, ImagEigValsScaled, HullRealScaled, HullImagScaled);
+   State.Iter = IterOffset + iter;
+   State.mu   = mu;
+   State.x.resize(NumUnknowns);
+   State.zL.resize(NumUnknowns);
+   State.zU.resize(NumUnknowns);
+   State.lambda.resize(NumConstr);
+   get_curr_iterate(ip_data, ip_cq, false, NumUnknowns, State.x.data(), State.zL.data(), State.zU.data(), 
+                    NumConstr, NULL, State.lambda.data());
+
+   State.xBest      = xyBest;
+   State.zLBest     = zLBest;
+   State.zUBest     = zUBest;
+   State.lambdaBest = lambdaBest;
+   State.BestObj    = BestObj;
+   State.BestInfPr  = BestInfPr;
+
+   if(!write_Checkpoint(CheckpointFile, State))
+      std::cout << "CARE: Could not write checkpoint " << CheckpointFile << std::endl;
+}
+
+Index Roots_RealImag::resume_from_checkpoint(
+   Number& mu
+)
+{
+   Checkpoint State;
+   if(!read_Checkpoint(CheckpointFile, State, NumUnknowns, NumEigVals + ConsOrder - 1)) {
+      std::cout << "No (valid) checkpoint " << CheckpointFile << " found, start from scratch" << std::endl;
+      return -1;
+   }
+   if(State.Signature != ProblemSignature("RealImag", NumStages, ConsOrder, NumStagesRef, dtRef, 
+                                          RealEigValsScaled, ImagEigValsScaled, HullRealScaled, HullImagScaled)) {
+      std::cout << "CARE: Checkpoint " << CheckpointFile << " belongs to a different problem, start from scratch" 
+                << std::endl;
+      return -1;
+   }
+   std::cout << "Resume from " << CheckpointFile << " at iteration " << State.Iter 
+             << " with mu = " << State.mu << std::endl;
+   mu = State.mu;
+
+   xyWarm  = State.x;
+   zL0     = State.zL;
+   zU0     = State.zU;
+   lambda0 = (State.lambda.size() == NumConstr) ? State.lambda : std::vector<Number>();
+
+   xyBest     = State.xBest;
+   zLBest     = State.zLBest;
+   zUBest     = State.zUBest;
+   lambdaBest = (State.lambdaBest.size() == NumConstr) ? State.lambdaBest : std::vector<Number>(NumConstr, 0.);
+   BestObj    = State.BestObj;
+   BestInfPr  = State.BestInfPr;
+
+   KeepBest   = true;
+   IterOffset = State.Iter;
+
+   return State.Iter;
+}
+
+void Roots_RealImag::set_budget(
+   const Number TimeBudget,
+   const Index  StagnationIter,
+   const Number StagnationTol,
+   const Number StagnationFeasTol
+)
+{
+   Budget.TimeBudget        = TimeBudget;
+   Budget.StagnationIter    = StagnationIter;
+   Budget.StagnationTol     = StagnationTol;
+   Budget.StagnationFeasTol = StagnationFeasTol;
+   Budget.start_run();
+}
+
+void Roots_RealImag::set_warm_start(
+   const std::vector<Number>& xy_,
+   const std::vector<Number>& zL0_,
+   const std::vector<Number>& zU0_,
+   const std::vector<Number>& lambda0_
+)
+{
+   xyWarm  = xy_;
+   zL0     = zL0_;
+   zU0     = zU0_;
+   lambda0 = lambda0_;
+}
+
+bool Roots_RealImag::enable_warm_start_persistence()
+{
+   WarmStartFile = WarmStartFileName("RealImag", NumStages, ConsOrder, NumStagesRef, dtRef, 
+                                     RealEigValsScaled, ImagEigValsScaled, HullRealScaled, HullImagScaled);
+
+   std::vector<Number> xy, zL, zU, lambda;
+   if(!read_WarmStart(WarmStartFile, xy, zL, zU, lambda) || xy.size() != NumUnknowns)
+      return false;
+
+   std::cout << "Warmstart from " << WarmStartFile << std::endl;
+   xyWarm = xy;
+   zL0    = zL;
+   zU0    = zU;
+   // Multipliers of a different number of constraints (e.g. changed aggregation) are not reused
+   lambda0 = (lambda.size() == NumConstr) ? lambda : std::vector<Number>();
+
+   return true;
+}
+
+void Roots_RealImag::set_aggregation(
+   const StabConstrAggregation Aggregation_,
+   const int                   NumBlocks,
+   const Number                AggrParam_
+)
+{
+   Aggregation = Aggregation_;
+   AggrParam   = AggrParam_;
+
+   if(Aggregation == NoAggregation)
+      NumStabConstr = NumEigVals;
+   else {
+      assert(NumBlocks >= 1 && AggrParam > 0.);
+      NumStabConstr = std::min(NumBlocks, NumEigVals);
+      StabConstrValues.resize(NumEigVals);
+   }
+   NumConstr = NumStabConstr + ConsOrder - 1;
+
+   std::cout << "Stability constraints: " << NumStabConstr;
+   if(Aggregation == KS_Aggregation)
+      std::cout << " Kreisselmeier-Steinhauser aggregated with rho = " << AggrParam;
+   else if(Aggregation == PNorm_Aggregation)
+      std::cout << " p-norm aggregated with P = " << AggrParam;
+   std::cout << std::endl << std::endl;
 }
-// [TNLP_finalize_solution]
@@ -0,0 +1,101 @@
+// This code is published under the Eclipse Public License.
+// If you have not obtained a copy of the EPL, you can find the license (version 2.0) at
+// https://www.eclipse.org/legal/epl-2.0/
+//
+// Authors:  Daniel Doehring                  RWTH Aachen University 2022-11-20
+
+#ifndef __SEMIINFINITE_HPP__
+#define __SEMIINFINITE_HPP__
+
+#include <cmath>
+#include <vector>
+#include <cassert>
+#include <algorithm>
+
+#include "RootDistribution.hpp" // For 'Dist'
+
+/*
+Helpers for the semi-infinite (exchange) formulation of the stability constraint.
+The spectrum envelope is treated as a polygonal curve z(s), parametrized by its arc length s.
+Constraints are imposed on a finite set of samples s_j, which is refined by the maximizers of |R(z(s))|
+between neighboring samples until the maximum over the whole curve is below 1 + tol.
+*/
+
+template <typename T>
+std::vector<T> CurveArcLengths(const std::vector<T>& CurveReal, const std::vector<T>& CurveImag) {
+  std::vector<T> ArcLengths(CurveReal.size());
+  ArcLengths[0] = 0.;
+  for(size_t i = 1; i < CurveReal.size(); i++)
+    ArcLengths[i] = ArcLengths[i-1] + Dist(CurveReal[i], CurveImag[i], CurveReal[i-1], CurveImag[i-1]);
+
+  return ArcLengths;
+}
+
+// Point on the polygonal curve at arc length 's'
+template <typename T>
+void CurvePoint(const T s, const std::vector<T>& ArcLengths,
+                const std::vector<T>& CurveReal, const std::vector<T>& CurveImag,
+                T& Real, T& Imag) {
+  if(s <= ArcLengths[0]) {
+    Real = CurveReal[0];
+    Imag = CurveImag[0];
+  }
+  else if(s >= ArcLengths.back()) {
+    Real = CurveReal.back();
+    Imag = CurveImag.back();
+  }
+  else {
+    const size_t ind = std::upper_bound(ArcLengths.begin(), ArcLengths.end(), s) - ArcLengths.begin();
+    const T Frac = (s - ArcLengths[ind-1]) / (ArcLengths[ind] - ArcLengths[ind-1]);
+
+    Real = CurveReal[ind-1] + (CurveReal[ind] - CurveReal[ind-1]) * Frac;
+    Imag = CurveImag[ind-1] + (CurveImag[ind] - CurveImag[ind-1]) * Frac;
+  }
+}
+
+// Equidistant (in arc length) samples including both end points of the curve
+template <typename T>
+std::vector<T> InitialCurveSamples(const int NumSamples, const std::vector<T>& ArcLengths) {
+  assert(NumSamples >= 2);
+  std::vector<T> Samples(NumSamples);
+  for(int i = 0; i < NumSamples; i++)
+    Samples[i] = ArcLengths.back() * i / (NumSamples - 1);
+
+  return Samples;
+}
+
+// Golden section search for the maximum of a (locally unimodal) function on [a, b]
+template <typename T, typename Func>
+T GoldenSectionMax(const Func& f, T a, T b, const T tol, T& fMax) {
+  const T InvPhi = 0.5 * (std::sqrt(5.) - 1.);
+
+  T c = b - InvPhi * (b - a);
+  T d = a + InvPhi * (b - a);
+  T fc = f(c), fd = f(d);
+
+  while(b - a > tol) {
+    if(fc > fd) {
+      b  = d;
+      d  = c;
+      fd = fc;
+      c  = b - InvPhi * (b - a);
+      fc = f(c);
+    }
+    else {
+      a  = c;
+      c  = d;
+      fc = fd;
+      d  = a + InvPhi * (b - a);
+      fd = f(d);
+    }
+  }
+
+  if(fc > fd) {
+    fMax = fc;
+    return c;
+  }
+  fMax = fd;
+  return d;
+}
+
+#endif
@@ -0,0 +1,187 @@
+// This code is published under the Eclipse Public License.
+// If you have not obtained a copy of the EPL, you can find the license (version 2.0) at
+// https://www.eclipse.org/legal/epl-2.0/
+//
+// Authors:  Daniel Doehring                  RWTH Aachen University 2022-11-20
+
+#ifndef __SPECTRA_HPP__
+#define __SPECTRA_HPP__
+
+#include <string>
+#include <iostream>
+#include <vector>
+#include <fstream>
+#include <sstream>
+#include <cassert>
+#include <algorithm>
+#include <cmath>
+
+#include "IO_Funcs.hpp"
+
+// Upper convex hull (monotone chain) of points sorted w.r.t. real part. Serves as interpolation curve.
+template <typename T>
+void UpperConvexHull(const std::vector<T>& Real, const std::vector<T>& Imag, 
+                     std::vector<T>& HullReal, std::vector<T>& HullImag) {
+  HullReal.clear();
+  HullImag.clear();
+
+  for(size_t i = 0; i < Real.size(); i++) {
+    // Identical real parts: Keep only the larger imaginary part (no vertical segments for interpolation)
+    if(!HullReal.empty() && Real[i] == HullReal.back()) {
+      if(Imag[i] <= HullImag.back())
+        continue;
+      HullReal.pop_back();
+      HullImag.pop_back();
+    }
+
+    // Remove points which are not right turns
+    while(HullReal.size() >= 2) {
+      const size_t n = HullReal.size();
+      const T Cross = (HullReal[n-1] - HullReal[n-2]) * (Imag[i] - HullImag[n-2]) - 
+                      (HullImag[n-1] - HullImag[n-2]) * (Real[i] - HullReal[n-2]);
+      if(Cross < 0)
+        break;
+      HullReal.pop_back();
+      HullImag.pop_back();
+    }
+
+    HullReal.push_back(Real[i]);
+    HullImag.push_back(Imag[i]);
+  }
+}
+
+/*
+Eigenvalues on or near the upper convex hull (of the same, sorted points): An eigenvalue is kept if its imaginary part
+is at most 'Tol' below the hull, i.e., the piecewise linear interpolation of the hull vertices.
+For combined spectra, the eigenvalues far inside the merged hull are (practically) redundant constraints.
+*/
+template <typename T>
+void keep_NearHull(std::vector<T>& Real, std::vector<T>& Imag,
+                   const std::vector<T>& HullReal, const std::vector<T>& HullImag, const T Tol) {
+  size_t j = 0, NumKept = 0;
+  for(size_t i = 0; i < Real.size(); i++) {
+    while(j + 1 < HullReal.size() && HullReal[j+1] < Real[i])
+      j++;
+
+    T HullValue = HullImag[j];
+    if(j + 1 < HullReal.size() && Real[i] > HullReal[j])
+      HullValue += (HullImag[j+1] - HullImag[j]) / (HullReal[j+1] - HullReal[j]) * (Real[i] - HullReal[j]);
+
+    if(Imag[i] >= HullValue - Tol) {
+      Real[NumKept] = Real[i];
+      Imag[NumKept] = Imag[i];
+      NumKept++;
+    }
+  }
+  Real.resize(NumKept);
+  Imag.resize(NumKept);
+}
+
+/*
+Joint optimization for several spectra (meshes, polynomial degrees, flow states, ...), each with its own
+reference timestep. Every line of the list file reads
+
+EigValFileName dtRef NumStagesRef
+
+The eigenvalues of spectrum k are rescaled by dtExp_k / dtExp_0 = (dtRef_k / NumStagesRef_k) / (dtRef_0 / NumStagesRef_0)
+such that the combined constraint set refers to the reference timestep of the first spectrum.
+The optimized timestep for spectrum k is then the optimized timestep times dtExp_k / dtExp_0.
+Only the eigenvalues on or near the upper convex hull of the merged spectra are kept as constraints, where 'near'
+means at most 'NearHullTol' times the largest magnitude below the hull.
+*/
+template <typename T>
+void read_Spectra(const std::string ListFileName, std::vector<T>& RealEigVals, std::vector<T>& ImagEigVals,
+                  T& dtRef0, int& NumStagesRef0, const T DedupTol, const T NearHullTol = 1e-2) {
+  std::ifstream ListFile(ListFileName);
+  assert(ListFile);
+
+  RealEigVals.clear();
+  ImagEigVals.clear();
+
+  std::string line;
+  int k = 0;
+  while (std::getline(ListFile, line)) {
+    if(line.empty() || line[0] == '#') // Allow for comments
+      continue;
+
+    std::stringstream stream(line);
+    std::string EigValFileName;
+    T dtRef;
+    int NumStagesRef;
+    stream >> EigValFileName >> dtRef >> NumStagesRef;
+    assert(stream && NumStagesRef > 0);
+
+    if(k == 0) {
+      dtRef0        = dtRef;
+      NumStagesRef0 = NumStagesRef;
+    }
+    const T Ratio = (dtRef / NumStagesRef) / (dtRef0 / NumStagesRef0);
+
+    int NumEigVals = -1;
+    std::vector<T> Real, Imag;
+    read_EigVals(EigValFileName, NumEigVals, Real, Imag);
+    for(int i = 0; i < NumEigVals; i++) {
+      RealEigVals.push_back(Real[i] * Ratio);
+      ImagEigVals.push_back(Imag[i] * Ratio);
+    }
+
+    std::cout << "Spectrum " << k << ": " << EigValFileName << " with dtRef = " << dtRef 
+              << ", NumStagesRef = " << NumStagesRef << " (timestep ratio " << Ratio << ")" 
+              << std::endl << std::endl;
+    k++;
+  }
+  ListFile.close();
+  assert(k > 0);
+
+  // Sort combined eigenvalues with ascending real part
+  sort_EigVals(RealEigVals, ImagEigVals);
+  const size_t NumCombined = RealEigVals.size();
+
+  std::cout << "Combined spectrum of " << k << " spectra has " << RealEigVals.size() << " eigenvalues" 
+            << std::endl << std::endl;
+
+  // Spectra of e.g. refined meshes overlap substantially
+  if(DedupTol > 0) {
+    std::vector<int> Multiplicity;
+    dedup_EigVals(RealEigVals, ImagEigVals, DedupTol, &Multiplicity);
+    std::cout << "Merged (near-)duplicate eigenvalues with tolerance " << DedupTol << ": " 
+              << NumCombined << " -> " << RealEigVals.size() << " eigenvalues" << std::endl;
+    report_Multiplicity(Multiplicity);
+    std::cout << std::endl;
+  }
+
+  // Merged hull: Constraints of eigenvalues far inside are redundant
+  std::vector<T> HullReal, HullImag;
+  UpperConvexHull(RealEigVals, ImagEigVals, HullReal, HullImag);
+  T MaxAbs = 0;
+  for(size_t i = 0; i < RealEigVals.size(); i++)
+    MaxAbs = std::max(MaxAbs, std::sqrt(RealEigVals[i] * RealEigVals[i] + ImagEigVals[i] * ImagEigVals[i]));
+
+  const size_t NumMerged = RealEigVals.size();
+  keep_NearHull(RealEigVals, ImagEigVals, HullReal, HullImag, NearHullTol * MaxAbs);
+  std::cout << "Kept " << RealEigVals.size() << " of " << NumMerged << " eigenvalues on or near the merged upper "
+            << "convex hull (" << HullReal.size() << " vertices)" << std::endl << std::endl;
+}
+
+// Eigenvalue files of a spectra list file (e.g. for hashing the inputs)
+inline std::vector<std::string> read_SpectraFileNames(const std::string ListFileName) {
+  std::ifstream ListFile(ListFileName);
+  assert(ListFile);
+
+  std::vector<std::string> EigValFileNames;
+  std::string line;
+  while (std::getline(ListFile, line)) {
+    if(line.empty() || line[0] == '#') // Allow for comments
+      continue;
+
+    std::stringstream stream(line);
+    std::string EigValFileName;
+    stream >> EigValFileName;
+    EigValFileNames.push_back(EigValFileName);
+  }
+  ListFile.close();
+
+  return EigValFileNames;
+}
+
+#endif
@@ -0,0 +1,161 @@
+// This code is published under the Eclipse Public License.
+// If you have not obtained a copy of the EPL, you can find the license (version 2.0) at
+// https://www.eclipse.org/legal/epl-2.0/
+//
+// Authors:  Daniel Doehring                  RWTH Aachen University 2022-11-20
+
+#ifndef __SPECTRUMBINARY_HPP__
+#define __SPECTRUMBINARY_HPP__
+
+#include <string>
+#include <vector>
+#include <fstream>
+#include <iostream>
+#include <cstring>
+#include <cstdint>
+#include <cstdio> // rename
+
+#include <fcntl.h>    // open
+#include <unistd.h>   // close
+#include <sys/mman.h> // mmap
+#include <sys/stat.h> // fstat
+
+/*
+Binary spectrum format (little-endian), written by 'Spectrum_Convert.exe':
+
+  char     Magic[8]    "OSPREIS1"
+  uint64_t NumEigVals
+  uint64_t NumHull     Number of hull points (0: no hull)
+  uint32_t Flags       Bit 0: Eigenvalues sorted with ascending real part
+  uint32_t Reserved
+  double   Scaling     Eigenvalues and hull points are 'Scaling' times the stored values (applied when read)
+  double   EigVals[2*NumEigVals]   (Re, Im) pairs
+  double   Hull[2*NumHull]         (Re, Im) pairs
+
+The file is mapped into memory, i.e., the values are copied once directly into the vectors of the callers.
+A binary spectrum is used in place of 'EigenvalueList.txt' and, if it contains a hull, also in place of the hull prefix
+('Spectrum.bin' for 'Hull' => 'Spectrum.bin_real.txt' and 'Spectrum.bin_imag.txt' are taken from the hull block).
+*/
+
+const char SpectrumMagic[8] = {'O', 'S', 'P', 'R', 'E', 'I', 'S', '1'};
+
+struct SpectrumHeader {
+  char     Magic[8];
+  uint64_t NumEigVals;
+  uint64_t NumHull;
+  uint32_t Flags;
+  uint32_t Reserved;
+  double   Scaling;
+};
+static_assert(sizeof(SpectrumHeader) == 40, "Binary spectrum header must not be padded");
+
+const uint32_t SpectrumSorted = 1;
+
+inline bool is_LittleEndian() {
+  const uint16_t One = 1;
+  return *reinterpret_cast<const uint8_t*>(&One) == 1;
+}
+
+inline bool is_BinarySpectrum(const std::string& FileName) {
+  std::ifstream File(FileName, std::ios::binary);
+  char Magic[8];
+  return File.read(Magic, 8) && std::memcmp(Magic, SpectrumMagic, 8) == 0;
+}
+
+// Read-only mapping of a binary spectrum, unmapped on destruction
+class MappedSpectrum {
+public:
+  MappedSpectrum(const std::string& FileName) : Addr(MAP_FAILED), Bytes(0), Header(NULL), EigVals(NULL), Hull(NULL) {
+    if(!is_LittleEndian()) {
+      std::cout << "CARE: Binary spectra are only supported on little-endian machines!" << std::endl;
+      return;
+    }
+
+    const int fd = open(FileName.c_str(), O_RDONLY);
+    if(fd < 0)
+      return;
+
+    struct stat Stat;
+    if(fstat(fd, &Stat) == 0 && Stat.st_size >= (off_t) sizeof(SpectrumHeader)) {
+      Bytes = Stat.st_size;
+      Addr  = mmap(NULL, Bytes, PROT_READ, MAP_PRIVATE, fd, 0);
+    }
+    close(fd); // Mapping stays valid
+    if(Addr == MAP_FAILED)
+      return;
+
+    Header = static_cast<const SpectrumHeader*>(Addr);
+    // Counts are checked one by one against the number of pairs in the file, thus without overflow
+    const uint64_t MaxPairs = (Bytes - sizeof(SpectrumHeader)) / (2 * sizeof(double));
+    if(std::memcmp(Header->Magic, SpectrumMagic, 8) != 0 ||
+       Header->NumEigVals > MaxPairs || Header->NumHull > MaxPairs - Header->NumEigVals) {
+      std::cout << "CARE: " << FileName << " is no valid binary spectrum!" << std::endl;
+      Header = NULL;
+      return;
+    }
+    // Sequential read of all values
+    madvise(Addr, Bytes, MADV_SEQUENTIAL);
+
+    EigVals = reinterpret_cast<const double*>(static_cast<const char*>(Addr) + sizeof(SpectrumHeader));
+    Hull    = EigVals + 2 * Header->NumEigVals;
+  }
+
+  ~MappedSpectrum() {
+    if(Addr != MAP_FAILED)
+      munmap(Addr, Bytes);
+  }
+
+  MappedSpectrum(const MappedSpectrum&) = delete;
+  MappedSpectrum& operator=(const MappedSpectrum&) = delete;
+
+  bool valid() const { return Header != NULL; }
+
+private:
+  void*  Addr;
+  size_t Bytes;
+
+public:
+  const SpectrumHeader* Header;
+  const double* EigVals;
+  const double* Hull;
+};
+
+// Writes eigenvalues and hull (may be empty) via a temporary file, i.e., a complete file or none.
+// The values are stored as given (bit-exact), 'Scaling' is only recorded in the header.
+inline bool write_BinarySpectrum(const std::string& FileName,
+                                 const std::vector<double>& RealEigVals, const std::vector<double>& ImagEigVals,
+                                 const std::vector<double>& HullReal, const std::vector<double>& HullImag,
+                                 const bool Sorted, const double Scaling) {
+  if(!is_LittleEndian())
+    return false;
+
+  SpectrumHeader Header;
+  std::memcpy(Header.Magic, SpectrumMagic, 8);
+  Header.NumEigVals = RealEigVals.size();
+  Header.NumHull    = HullReal.size();
+  Header.Flags      = Sorted ? SpectrumSorted : 0;
+  Header.Reserved   = 0;
+  Header.Scaling    = Scaling;
+
+  const std::string TmpFileName = FileName + ".tmp";
+  std::ofstream File(TmpFileName, std::ios::binary);
+  if(!File)
+    return false;
+  File.write(reinterpret_cast<const char*>(&Header), sizeof(Header));
+
+  for(size_t i = 0; i < RealEigVals.size(); i++) {
+    const double Pair[2] = {RealEigVals[i], ImagEigVals[i]};
+    File.write(reinterpret_cast<const char*>(Pair), sizeof(Pair));
+  }
+  for(size_t i = 0; i < HullReal.size(); i++) {
+    const double Pair[2] = {HullReal[i], HullImag[i]};
+    File.write(reinterpret_cast<const char*>(Pair), sizeof(Pair));
+  }
+  File.close();
+  if(!File)
+    return false;
+
+  return std::rename(TmpFileName.c_str(), FileName.c_str()) == 0;
+}
+
+#endif // __SPECTRUMBINARY_HPP__
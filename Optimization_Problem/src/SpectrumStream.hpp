@@ -0,0 +1,161 @@
+// This code is published under the Eclipse Public License.
+// If you have not obtained a copy of the EPL, you can find the license (version 2.0) at
+// https://www.eclipse.org/legal/epl-2.0/
+//
+// Authors:  Daniel Doehring                  RWTH Aachen University 2022-11-20
+
+#ifndef __SPECTRUMSTREAM_HPP__
+#define __SPECTRUMSTREAM_HPP__
+
+#include <string>
+#include <vector>
+#include <map>
+#include <iterator>
+#include <fstream>
+#include <iostream>
+#include <chrono>
+#include <cmath>
+#include <cassert>
+#include <cstring>
+
+#include <sys/stat.h> // stat
+
+#include "IO_Funcs.hpp" // For 'parse_Number'
+
+/*
+Streamed spectra: The eigenvalues 'a+bi' are read from stdin (file name "-") or a named pipe in chunks
+and only the upper convex hull of the points seen so far is kept. Memory is thus bounded by the hull size,
+independent of the number of eigenvalues. The hull serves as constraint set and as interpolation curve.
+Since the stability polynomial has real coefficients, eigenvalues with negative imaginary part are mirrored.
+*/
+
+inline bool is_SpectrumStream(const std::string& EigValFileName) {
+  struct stat Stat;
+  return EigValFileName == "-" || (stat(EigValFileName.c_str(), &Stat) == 0 && S_ISFIFO(Stat.st_mode));
+}
+
+// Upper convex hull under insertion of unsorted points, vertices sorted with ascending real part
+class OnlineUpperHull {
+public:
+  void insert(const double Re, const double Im) {
+    auto Next = Vertices.lower_bound(Re);
+
+    // Identical real parts: Keep only the larger imaginary part (as 'UpperConvexHull')
+    if(Next != Vertices.end() && Next->first == Re) {
+      if(Im <= Next->second)
+        return;
+      Next = Vertices.erase(Next);
+    }
+    // Point on or below the hull
+    else if(Next != Vertices.end() && Next != Vertices.begin() && !above(*std::prev(Next), *Next, Re, Im))
+      return;
+
+    const auto Curr = Vertices.emplace_hint(Next, Re, Im);
+
+    // Remove neighbors which are no longer strict right turns
+    while(true) {
+      const auto Right = std::next(Curr);
+      if(Right == Vertices.end() || std::next(Right) == Vertices.end() ||
+         above(*Curr, *std::next(Right), Right->first, Right->second))
+        break;
+      Vertices.erase(Right);
+    }
+    while(Curr != Vertices.begin()) {
+      const auto Left = std::prev(Curr);
+      if(Left == Vertices.begin() || above(*std::prev(Left), *Curr, Left->first, Left->second))
+        break;
+      Vertices.erase(Left);
+    }
+  }
+
+  size_t size() const { return Vertices.size(); }
+
+  template <typename T>
+  void get(std::vector<T>& HullReal, std::vector<T>& HullImag) const {
+    HullReal.clear();
+    HullImag.clear();
+    for(const auto& Vertex : Vertices) {
+      HullReal.push_back(Vertex.first);
+      HullImag.push_back(Vertex.second);
+    }
+  }
+
+private:
+  // Point strictly above the line through A and B (A left of B)
+  static bool above(const std::pair<const double, double>& A, const std::pair<const double, double>& B,
+                    const double Re, const double Im) {
+    return (B.first - A.first) * (Im - A.second) - (B.second - A.second) * (Re - A.first) > 0;
+  }
+
+  std::map<double, double> Vertices;
+};
+
+// Reads eigenvalues from stdin or a named pipe in chunks of 'ChunkBytes', returns the number of eigenvalues
+template <typename T>
+size_t read_EigVals_Stream(const std::string EigValFileName, std::vector<T>& HullReal, std::vector<T>& HullImag,
+                           const size_t ChunkBytes = 1 << 20) {
+  const auto Start = std::chrono::steady_clock::now();
+
+  std::ifstream Pipe;
+  if(EigValFileName != "-") {
+    Pipe.open(EigValFileName, std::ios::binary);
+    assert(Pipe);
+  }
+  std::istream& In = (EigValFileName == "-") ? std::cin : Pipe;
+
+  OnlineUpperHull Hull;
+  size_t NumEigVals = 0, NumPositive = 0, NumBytes = 0;
+
+  auto ParseLines = [&](const char* Curr, const char* End) {
+    while(Curr < End) {
+      const char* LineEnd = static_cast<const char*>(std::memchr(Curr, '\n', End - Curr));
+      if(LineEnd == NULL)
+        LineEnd = End;
+
+      double real, imag;
+      const char* Pos = parse_Number(Curr, LineEnd, real);
+      if(Pos != NULL) {
+        while(Pos < LineEnd && (*Pos == ' ' || *Pos == '\t'))
+          Pos++;
+        Pos = (Pos < LineEnd) ? parse_Number(Pos + 1, LineEnd, imag) : NULL;
+      }
+      // Blank lines are skipped silently
+      if(Pos != NULL) {
+        if(real > 0)
+          NumPositive++;
+        Hull.insert(real, std::abs(imag));
+        NumEigVals++;
+      }
+      Curr = LineEnd + 1;
+    }
+  };
+
+  // Chunk plus incomplete last line of the previous chunk
+  std::string Buffer;
+  std::vector<char> Chunk(ChunkBytes);
+  while(In) {
+    In.read(Chunk.data(), ChunkBytes);
+    const size_t NumRead = In.gcount();
+    NumBytes += NumRead;
+    Buffer.append(Chunk.data(), NumRead);
+
+    const size_t Complete = Buffer.rfind('\n');
+    if(Complete == std::string::npos)
+      continue;
+    ParseLines(Buffer.data(), Buffer.data() + Complete + 1);
+    Buffer.erase(0, Complete + 1);
+  }
+  // Last line without line break
+  ParseLines(Buffer.data(), Buffer.data() + Buffer.size());
+  Hull.get(HullReal, HullImag);
+
+  const double Seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - Start).count();
+  std::cout << "Streamed " << NumEigVals << " eigenvalues (" << NumBytes / 1e6 << " MB in " << Seconds
+            << " s), upper convex hull has " << Hull.size() << " points" << std::endl << std::endl;
+  if(NumPositive > 0)
+    std::cout << "CARE: " << NumPositive << " eigenvalues with positive real part, should be removed!" << std::endl;
+
+  return NumEigVals;
+}
+
+#endif // __SPECTRUMSTREAM_HPP__
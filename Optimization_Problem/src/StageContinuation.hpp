@@ -0,0 +1,84 @@
+// This code is published under the Eclipse Public License.
+// If you have not obtained a copy of the EPL, you can find the license (version 2.0) at
+// https://www.eclipse.org/legal/epl-2.0/
+//
+// Authors:  Daniel Doehring                  RWTH Aachen University 2022-11-20
+
+#ifndef __STAGECONTINUATION_HPP__
+#define __STAGECONTINUATION_HPP__
+
+#include <cmath>
+#include <vector>
+#include <cassert>
+#include <algorithm>
+
+#include "SemiInfinite.hpp" // For 'CurveArcLengths', 'CurvePoint'
+
+/*
+Helpers for the continuation in the number of stages S -> S + Step.
+The (sorted) real parts of the roots are mapped to arc length positions on the (scaled) interpolation curve,
+completed by the end of the curve (the "additional root" in the origin, see 'InitialRootDistr').
+This piecewise linear function of the root index is then resampled at NumRootsNew equidistant indices,
+which preserves the clustering of the roots of the previous solution.
+*/
+
+// Arc length position of the curve point with real part 'Real' (curve sorted by ascending real part)
+template <typename T>
+T ArcLengthOfReal(const T Real, const std::vector<T>& ArcLengths, 
+                  const std::vector<T>& CurveReal, const std::vector<T>& CurveImag) {
+  if(Real <= CurveReal[0])
+    return ArcLengths[0];
+  if(Real >= CurveReal.back())
+    return ArcLengths.back();
+
+  const size_t ind = std::upper_bound(CurveReal.begin(), CurveReal.end(), Real) - CurveReal.begin();
+  return ArcLengths[ind-1] + (ArcLengths[ind] - ArcLengths[ind-1]) * 
+                             (Real - CurveReal[ind-1]) / (CurveReal[ind] - CurveReal[ind-1]);
+}
+
+// Linear interpolation of 'Values' (given at integer indices) at the fractional index 'u'
+template <typename T>
+T IndexIntPol(const std::vector<T>& Values, const T u) {
+  const size_t ind = std::min(static_cast<size_t>(u), Values.size() - 2);
+  return Values[ind] + (Values[ind+1] - Values[ind]) * (u - ind);
+}
+
+// Real parts of 'NumRootsNew' roots from the real parts 'Roots' w.r.t. the same (scaled) curve
+template <typename T>
+std::vector<T> ResampleRoots(const std::vector<T>& Roots, const int NumRootsNew,
+                             const std::vector<T>& CurveReal, const std::vector<T>& CurveImag) {
+  const std::vector<T> ArcLengths = CurveArcLengths(CurveReal, CurveImag);
+
+  std::vector<T> RootsSorted(Roots);
+  std::sort(RootsSorted.begin(), RootsSorted.end());
+
+  const size_t NumRoots = RootsSorted.size();
+  std::vector<T> Positions(NumRoots + 1);
+  for(size_t i = 0; i < NumRoots; i++)
+    Positions[i] = ArcLengthOfReal(RootsSorted[i], ArcLengths, CurveReal, CurveImag);
+  Positions[NumRoots] = ArcLengths.back();
+
+  std::vector<T> RootsNew(NumRootsNew);
+  T Imag;
+  for(int j = 0; j < NumRootsNew; j++) {
+    const T u = static_cast<T>(j) * NumRoots / NumRootsNew;
+    CurvePoint(IndexIntPol(Positions, u), ArcLengths, CurveReal, CurveImag, RootsNew[j], Imag);
+  }
+
+  return RootsNew;
+}
+
+// Resampling of per-root quantities (e.g. bound multipliers) to 'NumRootsNew' entries
+template <typename T>
+std::vector<T> ResampleByIndex(const std::vector<T>& Values, const int NumRootsNew) {
+  if(Values.size() < 2)
+    return std::vector<T>(NumRootsNew, Values.empty() ? 0. : Values[0]);
+
+  std::vector<T> ValuesNew(NumRootsNew);
+  for(int j = 0; j < NumRootsNew; j++)
+    ValuesNew[j] = IndexIntPol(Values, static_cast<T>(j) * (Values.size() - 1) / std::max(NumRootsNew - 1, 1));
+
+  return ValuesNew;
+}
+
+#endif
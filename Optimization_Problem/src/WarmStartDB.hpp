@@ -0,0 +1,149 @@
+// This code is published under the Eclipse Public License.
+// If you have not obtained a copy of the EPL, you can find the license (version 2.0) at
+// https://www.eclipse.org/legal/epl-2.0/
+//
+// Authors:  Daniel Doehring                  RWTH Aachen University 2022-11-20
+
+#ifndef __WARMSTARTDB_HPP__
+#define __WARMSTARTDB_HPP__
+
+#include <string>
+#include <vector>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <limits>
+#include <cmath>
+#include <algorithm>
+
+#include "StageContinuation.hpp" // For 'ArcLengthOfReal', 'IndexIntPol', 'CurveArcLengths', 'CurvePoint'
+
+/*
+Database of optimized (real-only) root distributions for initializing similar problems.
+Solutions are stored independent of the scaling (dtExp) and resolution (mesh) of the spectrum:
+- The interpolation curve is described by 'NumShapeSamples' points at equidistant arc length, divided by its length.
+- Roots are stored as fractions of the curve length, the timestep as ratio dt/dtExp.
+The nearest record (shape distance plus penalty for differing S) of the same order p is mapped onto
+the curve of the new problem, resampling the roots if S differs.
+One file per order of consistency, every line is one record: S dt/dtExp NumShapeSamples Shape NumRoots Fractions
+*/
+
+static const int NumShapeSamples = 16;
+
+struct WarmStartRecord {
+  int NumStages;
+  double dtRatio;
+  std::vector<double> Shape;         // 2 * NumShapeSamples: Real and imaginary parts
+  std::vector<double> RootFractions; // Sorted, in [0, 1]
+};
+
+template <typename T>
+std::vector<double> CurveShape(const std::vector<T>& CurveReal, const std::vector<T>& CurveImag) {
+  const std::vector<T> ArcLengths = CurveArcLengths(CurveReal, CurveImag);
+  const T Length = ArcLengths.back();
+
+  std::vector<double> Shape(2 * NumShapeSamples);
+  T Real, Imag;
+  for(int i = 0; i < NumShapeSamples; i++) {
+    CurvePoint(Length * i / (NumShapeSamples - 1), ArcLengths, CurveReal, CurveImag, Real, Imag);
+    Shape[2*i]     = Real / Length;
+    Shape[2*i + 1] = Imag / Length;
+  }
+
+  return Shape;
+}
+
+template <typename T>
+std::vector<double> RootFractions(const std::vector<T>& Roots, 
+                                  const std::vector<T>& CurveReal, const std::vector<T>& CurveImag) {
+  const std::vector<T> ArcLengths = CurveArcLengths(CurveReal, CurveImag);
+
+  std::vector<double> Fractions(Roots.size());
+  for(size_t i = 0; i < Roots.size(); i++)
+    Fractions[i] = ArcLengthOfReal(Roots[i], ArcLengths, CurveReal, CurveImag) / ArcLengths.back();
+  std::sort(Fractions.begin(), Fractions.end());
+
+  return Fractions;
+}
+
+// Real parts of 'NumRoots' roots on the curve from (possibly differently many) root fractions
+template <typename T>
+std::vector<T> MapRootFractions(const std::vector<double>& Fractions, const int NumRoots,
+                                const std::vector<T>& CurveReal, const std::vector<T>& CurveImag) {
+  const std::vector<T> ArcLengths = CurveArcLengths(CurveReal, CurveImag);
+
+  // Complete by the end of the curve (the "additional root" in the origin, see 'InitialRootDistr')
+  std::vector<T> Positions(Fractions.begin(), Fractions.end());
+  Positions.push_back(1.);
+
+  std::vector<T> Roots(NumRoots);
+  T Imag;
+  for(int j = 0; j < NumRoots; j++) {
+    const T u = static_cast<T>(j) * Fractions.size() / NumRoots;
+    CurvePoint(IndexIntPol(Positions, u) * ArcLengths.back(), ArcLengths, CurveReal, CurveImag, Roots[j], Imag);
+  }
+
+  return Roots;
+}
+
+inline double RecordDistance(const WarmStartRecord& Record, const int NumStages, const std::vector<double>& Shape) {
+  double ShapeDist = 0.;
+  for(size_t i = 0; i < Shape.size(); i++)
+    ShapeDist += (Record.Shape[i] - Shape[i]) * (Record.Shape[i] - Shape[i]);
+
+  return std::sqrt(ShapeDist / NumShapeSamples) + 
+         0.1 * std::abs(std::log2(static_cast<double>(Record.NumStages) / NumStages));
+}
+
+inline std::string WarmStartDBFileName(const std::string DataBaseDir, const int ConsOrder) {
+  return DataBaseDir + "/WarmStartDB_p" + std::to_string(ConsOrder) + ".txt";
+}
+
+inline std::vector<WarmStartRecord> read_WarmStartDB(const std::string FileName) {
+  std::vector<WarmStartRecord> Records;
+  std::ifstream File(FileName);
+
+  std::string line;
+  while(std::getline(File, line)) {
+    std::stringstream stream(line);
+    WarmStartRecord Record;
+    int NumSamples, NumRoots;
+    stream >> Record.NumStages >> Record.dtRatio >> NumSamples;
+    if(!stream || NumSamples != NumShapeSamples) // Skip corrupted or incompatible records
+      continue;
+
+    Record.Shape.resize(2 * NumSamples);
+    for(double& Value : Record.Shape)
+      stream >> Value;
+    stream >> NumRoots;
+    if(!stream || NumRoots <= 0)
+      continue;
+    Record.RootFractions.resize(NumRoots);
+    for(double& Value : Record.RootFractions)
+      stream >> Value;
+
+    if(stream)
+      Records.push_back(Record);
+  }
+
+  return Records;
+}
+
+// Records are appended as single lines such that concurrent jobs do not interleave
+inline void append_WarmStartDB(const std::string FileName, const WarmStartRecord& Record) {
+  std::stringstream Line;
+  Line << std::setprecision(std::numeric_limits<double>::max_digits10);
+  Line << Record.NumStages << " " << Record.dtRatio << " " << NumShapeSamples;
+  for(const double Value : Record.Shape)
+    Line << " " << Value;
+  Line << " " << Record.RootFractions.size();
+  for(const double Value : Record.RootFractions)
+    Line << " " << Value;
+  Line << "\n";
+
+  std::ofstream File(FileName, std::ios::app);
+  File << Line.str();
+  File.close();
+}
+
+#endif
@@ -0,0 +1,125 @@
+// This code is published under the Eclipse Public License.
+// If you have not obtained a copy of the EPL, you can find the license (version 2.0) at
+// https://www.eclipse.org/legal/epl-2.0/
+//
+// Authors:  Daniel Doehring                  RWTH Aachen University 2022-11-20
+
+#ifndef __WARMSTARTIO_HPP__
+#define __WARMSTARTIO_HPP__
+
+#include <string>
+#include <vector>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <cstdint>
+#include <cstring>
+
+/*
+Persistence of primal-dual solutions (x, z_L, z_U, lambda) for warmstarting subsequent runs.
+Files are keyed by a signature of the problem (type, S, p, S_ref, dt_ref) and the contents of the constraint points,
+i.e., the (scaled) spectrum and hull as used by the optimization. Solutions are thus never mixed up between spectra.
+Layout: Magic (8 bytes), n, m (uint64), x, z_L, z_U (n doubles each), lambda (m doubles).
+*/
+
+// 64 bit Fowler-Noll-Vo (FNV-1a) hash
+inline uint64_t FNV1a(const void* Data, const size_t NumBytes, uint64_t Hash = 14695981039346656037ULL) {
+  const unsigned char* Bytes = static_cast<const unsigned char*>(Data);
+  for(size_t i = 0; i < NumBytes; i++) {
+    Hash ^= Bytes[i];
+    Hash *= 1099511628211ULL;
+  }
+  return Hash;
+}
+
+// Hash of the size and contents of a vector
+inline uint64_t HashVector(const std::vector<double>& Values, uint64_t Hash) {
+  const uint64_t Size = Values.size();
+  Hash = FNV1a(&Size, sizeof(Size), Hash);
+  return FNV1a(Values.data(), Size * sizeof(double), Hash);
+}
+
+// Signature of the problem: Type, S, p, S_ref, dt_ref and the constraint points (scaled spectrum and hull)
+inline uint64_t ProblemSignature(const std::string Problem, const int NumStages, const int ConsOrder, 
+                                 const int NumStagesRef, const double dtRef,
+                                 const std::vector<double>& RealEigVals, const std::vector<double>& ImagEigVals,
+                                 const std::vector<double>& HullReal, const std::vector<double>& HullImag) {
+  uint64_t Hash = FNV1a(Problem.data(), Problem.size());
+  Hash = FNV1a(&NumStages,    sizeof(NumStages),    Hash);
+  Hash = FNV1a(&ConsOrder,    sizeof(ConsOrder),    Hash);
+  Hash = FNV1a(&NumStagesRef, sizeof(NumStagesRef), Hash);
+  Hash = FNV1a(&dtRef,        sizeof(dtRef),        Hash);
+  Hash = HashVector(RealEigVals, Hash);
+  Hash = HashVector(ImagEigVals, Hash);
+  Hash = HashVector(HullReal,    Hash);
+  return HashVector(HullImag,   Hash);
+}
+
+inline std::string WarmStartFileName(const std::string Problem, const int NumStages, const int ConsOrder, 
+                                     const int NumStagesRef, const double dtRef,
+                                     const std::vector<double>& RealEigVals, const std::vector<double>& ImagEigVals,
+                                     const std::vector<double>& HullReal, const std::vector<double>& HullImag) {
+  const uint64_t Hash = ProblemSignature(Problem, NumStages, ConsOrder, NumStagesRef, dtRef, 
+                                         RealEigVals, ImagEigVals, HullReal, HullImag);
+
+  std::stringstream FileName;
+  FileName << "./WarmStart_" << Problem << "_" << NumStages << "_" 
+           << std::hex << std::setw(16) << std::setfill('0') << Hash << ".bin";
+  return FileName.str();
+}
+
+static const char WarmStartMagic[8] = {'O', 'S', 'P', 'R', 'E', 'I', 'W', '1'};
+
+inline void write_WarmStart(const std::string FileName, const std::vector<double>& x, 
+                            const std::vector<double>& zL, const std::vector<double>& zU, 
+                            const std::vector<double>& lambda) {
+  std::ofstream File(FileName, std::ios::binary);
+  const uint64_t n = x.size(), m = lambda.size();
+
+  File.write(WarmStartMagic, sizeof(WarmStartMagic));
+  File.write(reinterpret_cast<const char*>(&n), sizeof(n));
+  File.write(reinterpret_cast<const char*>(&m), sizeof(m));
+  File.write(reinterpret_cast<const char*>(x.data()),      n * sizeof(double));
+  File.write(reinterpret_cast<const char*>(zL.data()),     n * sizeof(double));
+  File.write(reinterpret_cast<const char*>(zU.data()),     n * sizeof(double));
+  File.write(reinterpret_cast<const char*>(lambda.data()), m * sizeof(double));
+  File.close();
+}
+
+// Returns false if the file does not exist or is corrupted
+inline bool read_WarmStart(const std::string FileName, std::vector<double>& x, 
+                           std::vector<double>& zL, std::vector<double>& zU, 
+                           std::vector<double>& lambda) {
+  std::ifstream File(FileName, std::ios::binary | std::ios::ate);
+  if(!File)
+    return false;
+  const uint64_t FileSize = File.tellg();
+  File.seekg(0);
+
+  char Magic[sizeof(WarmStartMagic)];
+  uint64_t n, m;
+  File.read(Magic, sizeof(Magic));
+  File.read(reinterpret_cast<char*>(&n), sizeof(n));
+  File.read(reinterpret_cast<char*>(&m), sizeof(m));
+  if(!File || std::memcmp(Magic, WarmStartMagic, sizeof(Magic)) != 0)
+    return false;
+
+  // Check the stored sizes against the file size before allocating (written such that 3n + m cannot overflow)
+  const uint64_t MaxValues = (FileSize - sizeof(WarmStartMagic) - sizeof(n) - sizeof(m)) / sizeof(double);
+  if(n > MaxValues / 3 || m > MaxValues - 3 * n || 
+     FileSize != sizeof(WarmStartMagic) + sizeof(n) + sizeof(m) + (3 * n + m) * sizeof(double))
+    return false;
+
+  x.resize(n);
+  zL.resize(n);
+  zU.resize(n);
+  lambda.resize(m);
+  File.read(reinterpret_cast<char*>(x.data()),      n * sizeof(double));
+  File.read(reinterpret_cast<char*>(zL.data()),     n * sizeof(double));
+  File.read(reinterpret_cast<char*>(zU.data()),     n * sizeof(double));
+  File.read(reinterpret_cast<char*>(lambda.data()), m * sizeof(double));
+
+  return static_cast<bool>(File);
+}
+
+#endif